@@ -0,0 +1,117 @@
+//
+// Copyright (C) 2020 Computer Science VII: Robotics and Telematics - 
+// Julius-Maximilians-Universitaet Wuerzburg
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see http://www.gnu.org/licenses/.
+//
+
+
+#include "TabulatedAntenna.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <map>
+#include <stdexcept>
+
+#include <inet/common/INETMath.h>
+
+#include "estnet/global_config.h"
+
+using namespace inet::math;
+
+namespace estnet {
+
+Define_Module(TabulatedAntenna);
+
+namespace {
+/** a loaded pattern together with its gain range */
+struct SharedPattern {
+    std::weak_ptr<const SphericalBilinearInterpolation> pattern;
+    double minGain;
+    double maxGain;
+};
+}
+
+void TabulatedAntenna::initialize(int stage) {
+    inet::physicallayer::AntennaBase::initialize(stage);
+    if (stage == 0) {
+        double minGain, maxGain;
+        auto pattern = loadPattern(par("patternFile").stdstringValue(),
+                par("usePatternCache").boolValue(), minGain, maxGain);
+        gain = inet::makeShared<TabulatedAntennaGain>(pattern, minGain,
+                maxGain);
+    }
+}
+
+std::shared_ptr<const SphericalBilinearInterpolation> TabulatedAntenna::loadPattern(
+        const std::string &path, bool useCache, double &minGain,
+        double &maxGain) {
+    static std::map<std::string, SharedPattern> patterns;
+    SharedPattern &shared = patterns[path];
+    std::shared_ptr<const SphericalBilinearInterpolation> pattern =
+            shared.pattern.lock();
+    if (!pattern) {
+        auto loaded = std::make_shared<SphericalBilinearInterpolation>();
+        try {
+            if (useCache) {
+                loaded->load_cached(path);
+            } else {
+                loaded->load(path);
+            }
+        } catch (const std::runtime_error &e) {
+            throw omnetpp::cRuntimeError("Cannot load antenna pattern %s: %s",
+                    path.c_str(), e.what());
+        }
+        // the file holds gains in dB, the interpolation works on fractions
+        shared.minGain = std::numeric_limits<double>::infinity();
+        shared.maxGain = -std::numeric_limits<double>::infinity();
+        loaded->apply([&shared](double gainDb) {
+            double gain = dB2fraction(gainDb);
+            shared.minGain = std::min(shared.minGain, gain);
+            shared.maxGain = std::max(shared.maxGain, gain);
+            return gain;
+        });
+        pattern = loaded;
+        shared.pattern = pattern;
+    }
+    minGain = shared.minGain;
+    maxGain = shared.maxGain;
+    return pattern;
+}
+
+std::ostream& TabulatedAntenna::printToStream(std::ostream &stream,
+        int level) const {
+    stream << "TabulatedAntenna";
+    stream << ", maxGain = " << gain->getMaxGain();
+    return inet::physicallayer::AntennaBase::printToStream(stream, level);
+}
+
+TabulatedAntenna::TabulatedAntennaGain::TabulatedAntennaGain(
+        std::shared_ptr<const SphericalBilinearInterpolation> pattern,
+        double minGain, double maxGain) :
+        pattern(pattern), minGain(minGain), maxGain(maxGain) {
+}
+
+double TabulatedAntenna::TabulatedAntennaGain::computeGain(
+        const inet::Quaternion direction) const {
+    // assumes analog model calculated direction in the antenna's
+    // coordinate frame, the boresight is the x axis
+    inet::Coord pointing = direction.rotate(inet::Coord::X_AXIS);
+    double theta = rad2deg(acos(std::max(-1.0, std::min(pointing.x, 1.0))));
+    double phi = rad2deg(atan2(pointing.z, pointing.y));
+    return pattern->get(theta, phi);
+}
+
+}  // namespace estnet
@@ -0,0 +1,91 @@
+//
+// Copyright (C) 2020 Computer Science VII: Robotics and Telematics - 
+// Julius-Maximilians-Universitaet Wuerzburg
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see http://www.gnu.org/licenses/.
+//
+
+
+#ifndef __ANTENNAS_TABULATED_ANTENNA_H__
+#define __ANTENNAS_TABULATED_ANTENNA_H__
+
+#include <memory>
+#include <string>
+
+#include <inet/common/Ptr.h>
+#include <inet/physicallayer/base/packetlevel/AntennaBase.h>
+
+#include "estnet/common/ESTNETDefs.h"
+#include "estnet/common/interpolation/SphericalBilinearInterpolation.h"
+
+namespace estnet {
+
+/**
+ * Antenna with a measured gain pattern, given on a regular grid over the
+ * off-boresight angle theta and the angle phi around the boresight.
+ * The gain is interpolated bilinearly. All antennas loading the same file
+ * share the pattern.
+ */
+class ESTNET_API TabulatedAntenna: public inet::physicallayer::AntennaBase {
+protected:
+    /** @brief initialization method */
+    virtual void initialize(int stage) override;
+
+    /**
+     * Gain class for a tabulated antenna pattern
+     */
+    class TabulatedAntennaGain: public inet::physicallayer::IAntennaGain {
+    public:
+        TabulatedAntennaGain(
+                std::shared_ptr<const SphericalBilinearInterpolation> pattern,
+                double minGain, double maxGain);
+        virtual double getMinGain() const override {
+            return minGain;
+        }
+        virtual double getMaxGain() const override {
+            return maxGain;
+        }
+        virtual double computeGain(const inet::Quaternion direction) const
+                override;
+
+    protected:
+        std::shared_ptr<const SphericalBilinearInterpolation> pattern;
+        double minGain;
+        double maxGain;
+    };
+
+    inet::Ptr<TabulatedAntennaGain> gain;
+
+    /**
+     * Returns the pattern of the file with gains converted from dB to
+     * fractions, loads it if no other antenna uses it yet
+     */
+    static std::shared_ptr<const SphericalBilinearInterpolation> loadPattern(
+            const std::string &path, bool useCache, double &minGain,
+            double &maxGain);
+
+public:
+    /** @brief Prints this object to the provided output stream */
+    virtual std::ostream& printToStream(std::ostream &stream, int level) const
+            override;
+    /** @brief Returns the gain of the antenna */
+    virtual inet::Ptr<const inet::physicallayer::IAntennaGain> getGain() const
+            override {
+        return gain;
+    }
+};
+
+}  // namespace estnet
+
+#endif
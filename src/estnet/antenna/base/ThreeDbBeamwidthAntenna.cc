@@ -18,6 +18,9 @@
 
 #include "ThreeDbBeamwidthAntenna.h"
 
+#include <algorithm>
+#include <limits>
+
 #include <inet/common/INETMath.h>
 
 #include "estnet/global_config.h"
@@ -35,8 +38,18 @@ void ThreeDbBeamwidthAntenna::initialize(int stage) {
         double minGain = inet::math::dB2fraction(par("minGain"));
         inet::units::values::deg beamWidth = inet::units::values::deg(
                 par("beamWidth"));
+        int gainTableSize = par("gainTableSize");
         gain = inet::makeShared<ThreeDbAntennaGain>(maxGain, minGain,
-                beamWidth);
+                beamWidth, gainTableSize);
+        if (gainTableSize > 0) {
+            double tolerance = par("gainTableTolerance");
+            double deviation = gain->getTableDeviation();
+            if (deviation > tolerance) {
+                throw omnetpp::cRuntimeError(
+                        "Gain table deviates by %g dB from the antenna pattern, increase gainTableSize",
+                        deviation);
+            }
+        }
     }
 }
 
@@ -53,21 +66,111 @@ inet::units::values::deg ThreeDbBeamwidthAntenna::getBeamWidth() {
 }
 
 ThreeDbBeamwidthAntenna::ThreeDbAntennaGain::ThreeDbAntennaGain(double maxGain,
-        double minGain, inet::units::values::deg beamWidth) :
+        double minGain, inet::units::values::deg beamWidth, int gainTableSize) :
         maxGain(maxGain), minGain(minGain), beamWidth(beamWidth) {
+    if (gainTableSize > 0) {
+        gainTable = getSharedTable(maxGain, beamWidth.get(), gainTableSize);
+    }
 }
 
-double ThreeDbBeamwidthAntenna::ThreeDbAntennaGain::computeGain(
-        const inet::Quaternion direction) const {
-    // assumes analog model calculated direction in the transmitters
-    // coordinate frame
+ThreeDbBeamwidthAntenna::ThreeDbAntennaGain::~ThreeDbAntennaGain() {
+    if (gainTable) {
+        // the antennas of a run are deleted at its end, so no table of
+        // earlier runs stays in the map
+        gainTable.reset();
+        GainTableMap &tables = getSharedTables();
+        for (auto it = tables.begin(); it != tables.end();) {
+            if (it->second.expired()) {
+                it = tables.erase(it);
+            } else {
+                ++it;
+            }
+        }
+    }
+}
 
-    double angle = acos(
-            direction.rotate(inet::Coord::X_AXIS) * inet::Coord::X_AXIS);
+ThreeDbBeamwidthAntenna::ThreeDbAntennaGain::GainTableMap&
+ThreeDbBeamwidthAntenna::ThreeDbAntennaGain::getSharedTables() {
+    static GainTableMap tables;
+    return tables;
+}
+
+std::shared_ptr<const ThreeDbBeamwidthAntenna::ThreeDbAntennaGain::GainTable>
+ThreeDbBeamwidthAntenna::ThreeDbAntennaGain::getSharedTable(double maxGain,
+        double beamWidth, int size) {
+    auto &entry = getSharedTables()[std::make_tuple(maxGain, beamWidth,
+            size)];
+    std::shared_ptr<const GainTable> table = entry.lock();
+    if (!table) {
+        ThreeDbAntennaGain analytic(maxGain, 0, inet::units::values::deg(
+                beamWidth));
+        auto newTable = std::make_shared<GainTable>(size + 1);
+        for (int i = 0; i <= size; i++) {
+            double cosAngle = std::min(-1.0 + 2.0 * i / size, 1.0);
+            // narrow beams underflow to 0 far off boresight, which
+            // must not become -inf in the interpolation
+            (*newTable)[i] = std::log(
+                    std::max(analytic.computeGain(cosAngle),
+                            std::numeric_limits<double>::min()));
+        }
+        table = newTable;
+        entry = table;
+    }
+    return table;
+}
+
+double ThreeDbBeamwidthAntenna::ThreeDbAntennaGain::getTableDeviation() const {
+    if (!gainTable) {
+        return 0;
+    }
+    double deviation = 0;
+    int size = gainTable->size() - 1;
+    // the first interval is not interpolated
+    for (int i = 1; i < size; i++) {
+        double cosAngle = -1.0 + (2.0 * i + 1) / size;
+        double exact = computeGain(cosAngle);
+        if (exact < maxGain * 1e-3) {
+            continue;
+        }
+        double interpolated = std::exp(
+                ((*gainTable)[i] + (*gainTable)[i + 1]) / 2);
+        deviation = std::max(deviation,
+                std::abs(fraction2dB(interpolated / exact)));
+    }
+    return deviation;
+}
+
+double ThreeDbBeamwidthAntenna::ThreeDbAntennaGain::computeGain(
+        double cosAngle) const {
+    double angle = acos(cosAngle);
 
     // the gain computation is actually from inet's ParabolAntenna, as the beam
     // width of it is a good enough approximation for our yagi for now
     return maxGain * dB2fraction(-3 * pow(angle / deg2rad(beamWidth.get()), 2));
 }
 
+double ThreeDbBeamwidthAntenna::ThreeDbAntennaGain::computeGain(
+        const inet::Quaternion direction) const {
+    // assumes analog model calculated direction in the transmitters
+    // coordinate frame
+    double cosAngle = direction.rotate(inet::Coord::X_AXIS)
+            * inet::Coord::X_AXIS;
+    if (!gainTable) {
+        return computeGain(cosAngle);
+    }
+
+    // interpolates the logarithm of the gain, the first interval is
+    // computed analytically as the pattern is not smooth in the cosine there
+    const GainTable &table = *gainTable;
+    int size = table.size() - 1;
+    double position = (std::max(-1.0, std::min(cosAngle, 1.0)) + 1) * 0.5
+            * size;
+    int index = std::min((int) position, size - 1);
+    if (index == 0) {
+        return computeGain(cosAngle);
+    }
+    double weight = position - index;
+    return std::exp(table[index] + weight * (table[index + 1] - table[index]));
+}
+
 }  // namespace estnet
@@ -19,6 +19,11 @@
 #ifndef __ANTENNAS_THREEDB_BEAMWIDTH_ANTENNA_H__
 #define __ANTENNAS_THREEDB_BEAMWIDTH_ANTENNA_H__
 
+#include <map>
+#include <memory>
+#include <tuple>
+#include <vector>
+
 #include <inet/common/Units.h>
 #include <inet/common/Ptr.h>
 #include <inet/physicallayer/base/packetlevel/AntennaBase.h>
@@ -31,6 +36,9 @@ namespace estnet {
  * Base class for antennas modeled via
  * a 3dB beam width.
  * The gain calculation is based on a gain range and the beam width.
+ * Optionally the gain is interpolated from a table over the cosine of the
+ * off-boresight angle, which is shared by all antennas with the same
+ * parameters.
  */
 class ESTNET_API ThreeDbBeamwidthAntenna: public inet::physicallayer::AntennaBase {
 protected:
@@ -42,8 +50,17 @@ protected:
      */
     class ThreeDbAntennaGain: public inet::physicallayer::IAntennaGain {
     public:
+        /** natural logarithm of the gain at equidistant cosines from -1 to 1 */
+        typedef std::vector<double> GainTable;
+        /** shared tables by maximum gain, beam width and size */
+        typedef std::map<std::tuple<double, double, int>,
+                std::weak_ptr<const GainTable>> GainTableMap;
+
         ThreeDbAntennaGain(double maxGain, double minGain,
-                inet::units::values::deg beamWidth);
+                inet::units::values::deg beamWidth, int gainTableSize = 0);
+        /** @brief releases the table, and drops the tables no antenna
+         *  uses anymore from the shared ones */
+        virtual ~ThreeDbAntennaGain();
         virtual double getMinGain() const override {
             return minGain;
         }
@@ -55,11 +72,27 @@ protected:
         }
         virtual double computeGain(const inet::Quaternion direction) const
                 override;
+        /** @brief analytic gain for the cosine of the off-boresight angle */
+        double computeGain(double cosAngle) const;
+        /**
+         * Returns the largest deviation of the table from the analytic
+         * pattern in dB, checked between the table entries wherever the
+         * gain is at most 30 dB below the maximum
+         */
+        double getTableDeviation() const;
 
     protected:
         double maxGain;
         double minGain;
         inet::units::values::deg beamWidth;
+        std::shared_ptr<const GainTable> gainTable;
+
+        /** @brief returns the table for the parameters, creates it if
+         *  no other antenna uses it yet */
+        static std::shared_ptr<const GainTable> getSharedTable(double maxGain,
+                double beamWidth, int size);
+        /** @brief returns the tables shared by the antennas */
+        static GainTableMap& getSharedTables();
     };
 
     inet::Ptr<ThreeDbAntennaGain> gain;
@@ -45,6 +45,10 @@ void BasicApp::initialize(int stage) {
                 par("printReceivedPacketsNo").boolValue();
         this->_printSentPacketsNo = par("printSentPacketsNo").boolValue();
         this->_printMissingPacketsNo = par("printMissingPacketsNo").boolValue();
+        // the sent and received lists can only be printed from full records,
+        // missing packets are derived from the received sequence numbers
+        this->_keepPacketRecords = par("keepPacketRecords").boolValue()
+                || this->_printSentPacketsNo || this->_printReceivedPacketsNo;
         this->_nodeId = par("nodeNo");
         this->_id = par("appId");
     } else if (stage == 1) {
@@ -135,13 +139,13 @@ void BasicApp::sendPacketInternal() {
                        << packet->getByteLength() << omnetpp::endl;
 
         // store packet informaion
-        PacketInformation pktInfo;
-        pktInfo.nodeId = getNodeId();
-        pktInfo.appId = this->_id;
-        pktInfo.pktId = this->_numSent;
-
-        //auto sequenceNumber = node->getCurrentSequenceNumber();
-        this->_packetsGenerated.push_back(pktInfo);
+        if (this->_keepPacketRecords) {
+            PacketInformation pktInfo;
+            pktInfo.nodeId = getNodeId();
+            pktInfo.appId = this->_id;
+            pktInfo.pktId = this->_numSent;
+            this->_packetsGenerated.push_back(pktInfo);
+        }
         this->_numSent++;
     }
     this->scheduleNextPacket();
@@ -192,7 +196,11 @@ void BasicApp::recvPacketInternal(omnetpp::cMessage *msg) {
                        << rcvdPacket.numHops << " hops." << omnetpp::endl;
         this->_numReceived++;
 
-        this->_packetsReceived.push_back(rcvdPacket);
+        this->_receivedSequenceNumbers[std::make_pair(rcvdPacket.nodeId,
+                rcvdPacket.appId)].insert(rcvdPacket.pktId);
+        if (this->_keepPacketRecords) {
+            this->_packetsReceived.push_back(rcvdPacket);
+        }
     }
 }
 
@@ -246,18 +254,16 @@ void BasicApp::finish() {
             EV_INFO << "Missing packets from Node" << nodeId << ": ";
             for (const auto app : apps) {
                 unsigned int appId = app->getId();
-                for (unsigned int i = 0; i < app->getPktSent(); i++) {
-                    bool received = false;
-                    for (const auto rPkt : this->_packetsReceived) {
-                        if (rPkt.appId == appId && rPkt.nodeId == nodeId
-                                && rPkt.pktId == i) {
-                            received = true;
-                            break;
-                        }
-                    }
-                    if (!received) {
-                        EV_INFO << nodeId << "." << appId << "." << i << ", ";
-                    }
+                auto printMissing = [this, nodeId, appId](unsigned long i) {
+                    EV_INFO << nodeId << "." << appId << "." << i << ", ";
+                };
+                auto it = this->_receivedSequenceNumbers.find(
+                        std::make_pair(nodeId, appId));
+                if (it != this->_receivedSequenceNumbers.end()) {
+                    it->second.forEachMissing(app->getPktSent(), printMissing);
+                } else {
+                    SequenceNumberSet().forEachMissing(app->getPktSent(),
+                            printMissing);
                 }
             }
             EV_INFO << omnetpp::endl;
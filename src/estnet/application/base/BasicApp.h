@@ -31,6 +31,7 @@
 #include "estnet/application/common/SrcNodeIdTag_m.h"
 #include "estnet/protocol/common/NumHopsHeader_m.h"
 #include "estnet/common/AddressUtils.h"
+#include "estnet/common/SequenceNumberSet.h"
 #include "estnet/common/node/NodeRegistry.h"
 
 namespace estnet {
@@ -70,8 +71,12 @@ protected:
     bool _printReceivedPacketsNo;
     bool _printSentPacketsNo;
     bool _printMissingPacketsNo;
+    // whether every sent and received packet is stored for printing
+    bool _keepPacketRecords;
     std::vector<PacketInformation> _packetsGenerated;
     std::vector<PacketInformation> _packetsReceived;
+    // received sequence numbers per source node and app
+    std::map<std::pair<unsigned int, unsigned int>, SequenceNumberSet> _receivedSequenceNumbers;
 
     /** @brief initialization */
     virtual void initialize(int stage) override;
@@ -18,6 +18,8 @@
 
 #include "AppHost.h"
 
+#include <cstring>
+
 namespace estnet {
 
 Define_Module(AppHost)
@@ -37,14 +39,30 @@ int AppHost::numInitStages() const {
     return 1;
 }
 void AppHost::initialize(int stage) {
-    //nothing to do here
+    this->handleParameterChange(nullptr);
+}
+
+void AppHost::handleParameterChange(const char *parname) {
+    if (parname == nullptr || strcmp(parname, "nodeNo") == 0) {
+        this->_nodeNo = this->par("nodeNo").intValue();
+    }
+    if (parname == nullptr || strcmp(parname, "numApps") == 0) {
+        this->_numApps = this->par("numApps").intValue();
+        // the ids of a gate vector's elements are base id + index,
+        // the base id stays valid if the vector is resized
+        this->_toAppGateBaseId = this->gateBaseId(TO_APP_GATE_NAME);
+        this->_fromAppGateBaseId = this->gateBaseId(FROM_APP_GATE_NAME);
+        this->_fromProtocolGateId = this->gateBaseId(FROM_PROTOCOL_GATE_NAME);
+    }
 }
 
 void AppHost::handleMessage(omnetpp::cMessage *message) {
-    if (message->arrivedOn(FROM_APP_GATE_NAME)) {
+    int arrivalGateId = message->getArrivalGateId();
+    if (arrivalGateId >= this->_fromAppGateBaseId
+            && arrivalGateId <= this->_fromAppGateBaseId + this->_numApps) {
         // we got a new packet to be send out from the upper layer
         this->receivedFromApp(omnetpp::check_and_cast<inet::Packet*>(message));
-    } else if (message->arrivedOn(FROM_PROTOCOL_GATE_NAME)) {
+    } else if (arrivalGateId == this->_fromProtocolGateId) {
         // we got a new frame to be handled from the lower layer
         this->receivedFromProtocolModule(
                 omnetpp::check_and_cast<inet::Packet*>(message));
@@ -76,7 +94,7 @@ void AppHost::receivedFromApp(inet::Packet *pkt) {
     auto destTag = pkt->getTag<DestNodeIdTag>();
     auto destId = destTag->getDestNodeId();
 
-    unsigned int sourceId = this->par("nodeNo");
+    unsigned int sourceId = this->_nodeNo;
     auto header = inet::makeShared<AppHostHeader>();
     header->setDestNodeID(destId);
     header->setSourceNodeID(sourceId);
@@ -94,13 +112,12 @@ void AppHost::receivedFromApp(inet::Packet *pkt) {
 void AppHost::sendToApp(inet::Packet *pkt) {
     auto appHeader = pkt->peekAtFront<AppHeader>();
     uint16_t destAppId = appHeader.get()->getDestAppID();
-    int numApps = this->par("numApps");
     // destAppId is zero based, numApps not
-    if (destAppId + 1 > numApps) {
+    if (destAppId + 1 > this->_numApps) {
         throw omnetpp::cRuntimeError(
                 "The destinationAppId does not exist. Are there the same number of apps on all nodes or are they correctly mapped if not?");
     } else {
-        this->send(pkt, TO_APP_GATE_NAME, destAppId);
+        this->send(pkt, this->_toAppGateBaseId + destAppId);
     }
 }
 
@@ -39,6 +39,12 @@ namespace estnet {
 class ESTNET_API AppHost: public omnetpp::cSimpleModule {
 private:
     long _numSent = 0;
+    // parameters and the toApp gate, resolved once instead of per packet
+    unsigned int _nodeNo = 0;
+    int _numApps = 0;
+    int _toAppGateBaseId = -1;
+    int _fromAppGateBaseId = -1;
+    int _fromProtocolGateId = -1;
 protected:
     static constexpr char FROM_APP_GATE_NAME[] = "fromApp";
     static constexpr char TO_APP_GATE_NAME[] = "toApp";
@@ -56,6 +62,8 @@ public:
     virtual void initialize(int stage) override;
     /** @brief receives packets from radios or apps */
     virtual void handleMessage(omnetpp::cMessage *message) override;
+    /** @brief refreshes the cached parameters if they change */
+    virtual void handleParameterChange(const char *parname) override;
 
     /** @brief called when the protocol returns a packet */
     virtual void receivedFromProtocolModule(inet::Packet *pkt);
@@ -29,6 +29,8 @@ namespace estnet {
  */
 class ESTNET_API IPositionData {
 public:
+    virtual ~IPositionData() {
+    }
     /** @brief gets the multiplier for on point*/
     virtual void getDataForPoint(double latitude, double longitude,
             double &multiplier) = 0;
@@ -37,6 +37,11 @@ namespace estnet {
 Define_Module(PositionBasedApp);
 
 void PositionBasedApp::initialize(int stage) {
+    // the app schedules its packets itself and only needs the first stage
+    // of BasicApp, running it again would take the shared data twice
+    if (stage != 0) {
+        return;
+    }
     BasicApp::initialize(0);
 
     this->earthModel = EarthModelFactory::get(
@@ -56,10 +61,13 @@ void PositionBasedApp::initialize(int stage) {
     std::smatch m;
     std::regex r_coordinats("^(\\-?\\d+(\\.\\d+)?),\\s(\\-?\\d+(\\.\\d+)?)");
     if (s.compare("AIS") == 0) {
-        pd = new AISDataLoader(this->par("dataPath").stdstringValue());
+        pd = new AISDataLoader(this->par("dataPath").stdstringValue(),
+                this->par("useDataCache").boolValue(),
+                this->par("dataCacheDirectory").stdstringValue());
     } else if (s.compare("Memorized") == 0) {
         pd = MemorizedDataHandler::getInstance(satMobility, earthModel,
                 this->par("dataPath").stdstringValue());
+        _sharedPositionData = true;
     } else if (regex_search(s, m, r_coordinats)) {
         pd = new GeoCoordinateDataHandler(s);
     } else {
@@ -80,6 +88,11 @@ void PositionBasedApp::initialize(int stage) {
 
 PositionBasedApp::~PositionBasedApp() {
     this->cancelAndDelete(this->_scheduleMsgEmpty);
+    if (_sharedPositionData) {
+        MemorizedDataHandler::releaseInstance();
+    } else {
+        delete pd;
+    }
 }
 
 void PositionBasedApp::handleMessage(omnetpp::cMessage *msg) {
@@ -32,7 +32,9 @@ namespace estnet {
  */
 class ESTNET_API PositionBasedApp: public BasicApp {
 protected:
-    IPositionData *pd;
+    IPositionData *pd = nullptr;
+    // pd is the shared MemorizedDataHandler instance
+    bool _sharedPositionData = false;
     virtual ~PositionBasedApp();
     /** @brief initialization */
     virtual void initialize(int stage) override;
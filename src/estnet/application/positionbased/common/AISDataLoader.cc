@@ -20,27 +20,45 @@
 
 #include <string>
 #include <sstream>
+#include <fstream>
 #include <algorithm>
 #include <cmath>
+#include <cstdint>
+#include <vector>
 
 #include <inet/common/INETMath.h>
 
 #include "estnet/global_config.h"
+#include "estnet/common/FileUtils.h"
 
 namespace estnet {
 
-AISDataLoader::AISDataLoader(std::string path) {
+// identifies the binary cache format
+static const char AIS_CACHE_MAGIC[8] = { 'E', 'S', 'T', 'A', 'I', 'S', '0',
+        '1' };
 
+AISDataLoader::AISDataLoader(std::string path, bool useCache,
+        const std::string &cacheDirectory) :
+        data(180, 360) {
+    std::string cachePath = getCachePath(path, cacheDirectory);
+    if (useCache && this->loadCache(cachePath, path)) {
+        return;
+    }
+    this->parseDataFile(path);
+    if (useCache) {
+        this->saveCache(cachePath, path);
+    }
+}
+
+void AISDataLoader::parseDataFile(const std::string &path) {
     //reads data file
-    file.open(path);
+    std::ifstream file(path);
     //checks if file is open
     if (file.is_open()) {
         //Iterates over all data
-        for (unsigned int i = 0; i < 64800; i++) {
-            std::string line;
-            std::getline(file, line);
-
-            if (line.find("ID") != 0) {
+        std::string line;
+        while (std::getline(file, line)) {
+            if (!line.empty() && line.find("ID") != 0) {
                 // search for the longitude value
                 int j = line.find('\t') + 1;
                 int k = line.find('\t', j);
@@ -59,21 +77,75 @@ AISDataLoader::AISDataLoader(std::string path) {
                 std::string s = line.substr(j, k - j);
                 std::replace(s.begin(), s.end(), ',', '.');
                 // saves multiplier in data array and add length to compensate negative values
-                data[latitude + 90][longitude + 180] = std::stof(s);
+                data.set(latitude + 90, longitude + 180, std::stof(s));
             }
         }
+        data.build();
 
         file.close();
     } else {
         std::ostringstream oss;
         oss << "AIS data loader file: " << path << " not found.";
-        const char *errorMsg = oss.str().c_str();
-        throw omnetpp::cRuntimeError(errorMsg);
+        throw omnetpp::cRuntimeError("%s", oss.str().c_str());
+    }
+}
+
+bool AISDataLoader::loadCache(const std::string &cachePath,
+        const std::string &path) {
+    std::ifstream cache(cachePath, std::ios::binary);
+    int64_t remaining;
+    if (!cache.is_open()
+            || !readCacheHeader(cache, AIS_CACHE_MAGIC, path, remaining)) {
+        return false;
+    }
+    int32_t rows, cols;
+    cache.read(reinterpret_cast<char*>(&rows), sizeof(rows));
+    cache.read(reinterpret_cast<char*>(&cols), sizeof(cols));
+    if (!cache || rows != data.getRows() || cols != data.getCols()
+            || remaining != (int64_t) (sizeof(rows) + sizeof(cols)
+                    + rows * cols * sizeof(float))) {
+        return false;
+    }
+    std::vector<float> values(rows * cols);
+    cache.read(reinterpret_cast<char*>(values.data()),
+            values.size() * sizeof(float));
+    if (!cache) {
+        return false;
+    }
+    for (int lat = 0; lat < rows; lat++) {
+        for (int lon = 0; lon < cols; lon++) {
+            data.set(lat, lon, values[lat * cols + lon]);
+        }
+    }
+    data.build();
+    return true;
+}
+
+void AISDataLoader::saveCache(const std::string &cachePath,
+        const std::string &path) {
+    int32_t rows = data.getRows();
+    int32_t cols = data.getCols();
+    // the multipliers are parsed as float, so storing floats is lossless
+    std::vector<float> values(rows * cols);
+    for (int lat = 0; lat < rows; lat++) {
+        for (int lon = 0; lon < cols; lon++) {
+            values[lat * cols + lon] = data.get(lat, lon);
+        }
     }
+    // failures are ignored, e.g. in a read-only directory the data file
+    // is parsed every run
+    writeFileAtomically(cachePath, [&](std::ostream &cache) {
+        if (!writeCacheHeader(cache, AIS_CACHE_MAGIC, path)) {
+            return;
+        }
+        cache.write(reinterpret_cast<const char*>(&rows), sizeof(rows));
+        cache.write(reinterpret_cast<const char*>(&cols), sizeof(cols));
+        cache.write(reinterpret_cast<const char*>(values.data()),
+                values.size() * sizeof(float));
+    });
 }
 
 AISDataLoader::~AISDataLoader() {
-    delete &file;
 }
 
 void AISDataLoader::getDataForPoint(double latitude, double longitude,
@@ -81,12 +153,19 @@ void AISDataLoader::getDataForPoint(double latitude, double longitude,
     // gets multiplier for one point
     int lon = std::floor(longitude) + 180;
     int lat = std::floor(latitude) + 90;
-    multiplier = data[lat][lon];
+    multiplier = data.get(lat, lon);
+}
+
+double AISDataLoader::sumInCircle(double latIndex, double lonIndex, double r,
+        int minLat, int maxLat) {
+    // points left of 0 and right of 359 wrap around to the other side
+    return data.sumInCircle(latIndex, lonIndex, r, minLat, maxLat)
+            + data.sumInCircle(latIndex, lonIndex + 360, r, minLat, maxLat)
+            + data.sumInCircle(latIndex, lonIndex - 360, r, minLat, maxLat);
 }
 
 void AISDataLoader::getDataForCone(double latitude, double longitude,
         double altitude, double beamWidth, double &multiplier) {
-    multiplier = 0;
     double alt = std::round(altitude);
     // calculates the radius of a circle around the center point in degree,
     // which can be directly added to latitude/longitude
@@ -97,32 +176,18 @@ void AISDataLoader::getDataForCone(double latitude, double longitude,
                             std::asin(
                                     alt * std::sin(inet::math::deg2rad(alpha))
                                             / EARTH_AVG_R))) - alpha;
-    // iterates over a 2r by 2r square and finds all points inside a circle with radius r
-    // and center point lat/lon
-    for (int i = std::floor(latitude - r + 90);
-            i <= std::floor(latitude + r + 90); i++) {
-        for (int j = std::floor(longitude - r + 180);
-                j <= std::floor(longitude + r + 180); j++) {
-            if (std::pow(i - (latitude + 90), 2)
-                    + std::pow(j - (longitude + 180), 2) <= std::pow(r, 2)) {
-                //adjusts the coordinates if they are over the array boundaries
-                int ii, jj;
-                if (i < 0) {
-                    ii = std::abs(i);
-                } else if (i > 180) {
-                    ii = 180 - (i % 180);
-                } else {
-                    ii = i;
-                }
-                if (j < 0) {
-                    jj = 360 + j;
-                } else {
-                    jj = j % 360;
-                }
-                multiplier += data[ii][jj];
-            }
-        }
-    }
+    // sums up all points inside a circle with radius r and center point lat/lon;
+    // points beyond the poles are mirrored back into the grid, which is the
+    // same as mirroring the center point and only taking the mirrored rows
+    double lat = latitude + 90;
+    double lon = longitude + 180;
+    multiplier = this->sumInCircle(lat, lon, r, 0, 179)
+            // below the south pole, index -i maps to i
+            + this->sumInCircle(-lat, lon, r, 1, 179)
+            // beyond the north pole, index i maps to 360 - i
+            + this->sumInCircle(360 - lat, lon, r, 1, 179)
+            // the north pole itself maps to the last row
+            + this->sumInCircle(lat - 1, lon, r, 179, 179);
 }
 
 }  // namespace estnet
@@ -19,9 +19,10 @@
 #ifndef __APPS__AIS_DATA_LOADER_H__
 #define __APPS__AIS_DATA_LOADER_H__
 
-#include <fstream>
+#include <string>
 
 #include "estnet/application/contract/IPositionData.h"
+#include "GridQuadtree.h"
 
 namespace estnet {
 
@@ -29,11 +30,20 @@ namespace estnet {
  *  It loads AIS ship data from a specified file. For each integer pair of latitude and longitude
  *  a single multiplier is loaded representing the mean number of ships at this point. When the data
  *  is accessed the multipliers are just returned.
+ *  The multipliers are kept in a quadtree, so the sum inside a beam only visits the cells at the
+ *  border of the beam which contain ships. The parsed data is cached in a binary file next to the
+ *  data file or in a cache directory, which is reused as long as the data file is not changed.
  */
 
 class ESTNET_API AISDataLoader: public IPositionData {
 public:
-    AISDataLoader(std::string path);
+    /**
+     * @param path: AIS data file
+     * @param useCache: keep the parsed data in a binary cache
+     * @param cacheDirectory: directory of the cache, next to the data file if empty
+     */
+    AISDataLoader(std::string path, bool useCache = true,
+            const std::string &cacheDirectory = "");
     virtual ~AISDataLoader();
     /** @brief gives multiplier for one specific longitude and latitude*/
     virtual void getDataForPoint(double latitude, double longitude,
@@ -42,8 +52,18 @@ public:
     virtual void getDataForCone(double latitude, double longitude,
             double altitude, double beamWidth, double &multiplier) override;
 private:
-    double data[180][360];
-    std::ifstream file;
+    /** @brief parses the AIS text file */
+    void parseDataFile(const std::string &path);
+    /** @brief loads the binary cache, returns false if it is missing or outdated */
+    bool loadCache(const std::string &cachePath, const std::string &path);
+    /** @brief writes the binary cache atomically, failures are ignored */
+    void saveCache(const std::string &cachePath, const std::string &path);
+    /** @brief sums up the cells inside the beam for one longitude wrap */
+    double sumInCircle(double latIndex, double lonIndex, double r, int minLat,
+            int maxLat);
+
+    // multipliers indexed by [latitude + 90][longitude + 180]
+    GridQuadtree data;
 };
 
 }  // namespace estnet
@@ -0,0 +1,130 @@
+//
+// Copyright (C) 2020 Computer Science VII: Robotics and Telematics - 
+// Julius-Maximilians-Universitaet Wuerzburg
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see http://www.gnu.org/licenses/.
+//
+
+
+#include "GridQuadtree.h"
+
+#include <algorithm>
+
+namespace estnet {
+
+GridQuadtree::GridQuadtree(int rows, int cols) :
+        _rows(rows), _cols(cols) {
+    Level cells;
+    cells.rows = rows;
+    cells.cols = cols;
+    cells.sum.assign(rows * cols, 0);
+    cells.nonZero.assign(rows * cols, 0);
+    this->_levels.push_back(cells);
+    this->build();
+}
+
+void GridQuadtree::set(int row, int col, double value) {
+    this->_levels[0].sum[row * this->_cols + col] = value;
+    this->_levels[0].nonZero[row * this->_cols + col] = value != 0 ? 1 : 0;
+}
+
+void GridQuadtree::build() {
+    this->_levels.resize(1);
+    while (this->_levels.back().rows > 1 || this->_levels.back().cols > 1) {
+        const Level &lower = this->_levels.back();
+        Level upper;
+        upper.rows = (lower.rows + 1) / 2;
+        upper.cols = (lower.cols + 1) / 2;
+        upper.sum.assign(upper.rows * upper.cols, 0);
+        upper.nonZero.assign(upper.rows * upper.cols, 0);
+        for (int row = 0; row < lower.rows; row++) {
+            for (int col = 0; col < lower.cols; col++) {
+                int from = row * lower.cols + col;
+                int to = (row / 2) * upper.cols + col / 2;
+                upper.sum[to] += lower.sum[from];
+                upper.nonZero[to] += lower.nonZero[from];
+            }
+        }
+        this->_levels.push_back(upper);
+    }
+}
+
+double GridQuadtree::sumInCircle(double centerRow, double centerCol,
+        double radius, int minRow, int maxRow) const {
+    Query query;
+    query.centerRow = centerRow;
+    query.centerCol = centerCol;
+    query.radius2 = radius * radius;
+    query.minRow = std::max(minRow, 0);
+    query.maxRow = std::min(maxRow, this->_rows - 1);
+    if (radius < 0 || query.minRow > query.maxRow) {
+        return 0;
+    }
+    return this->sumInCircle(query, this->_levels.size() - 1, 0, 0);
+}
+
+double GridQuadtree::sumInCircle(const Query &query, int level, int row,
+        int col) const {
+    const Level &node = this->_levels[level];
+    int index = row * node.cols + col;
+    if (node.nonZero[index] == 0) {
+        return 0;
+    }
+
+    // cells covered by this node, clipped to the grid and the row range
+    int firstRow = row << level;
+    int lastRow = std::min(((row + 1) << level) - 1, this->_rows - 1);
+    int firstCol = col << level;
+    int lastCol = std::min(((col + 1) << level) - 1, this->_cols - 1);
+    bool clipped = firstRow < query.minRow || lastRow > query.maxRow;
+    firstRow = std::max(firstRow, query.minRow);
+    lastRow = std::min(lastRow, query.maxRow);
+    if (firstRow > lastRow) {
+        return 0;
+    }
+
+    // the circle misses the node if its nearest cell is outside
+    double nearRow = std::min(std::max(query.centerRow, (double) firstRow),
+            (double) lastRow) - query.centerRow;
+    double nearCol = std::min(std::max(query.centerCol, (double) firstCol),
+            (double) lastCol) - query.centerCol;
+    if (nearRow * nearRow + nearCol * nearCol > query.radius2) {
+        return 0;
+    }
+    if (level == 0) {
+        return node.sum[index];
+    }
+
+    // the circle covers the node if its farthest corner is inside
+    double farRow = std::max(query.centerRow - firstRow,
+            lastRow - query.centerRow);
+    double farCol = std::max(query.centerCol - firstCol,
+            lastCol - query.centerCol);
+    if (!clipped && farRow * farRow + farCol * farCol <= query.radius2) {
+        return node.sum[index];
+    }
+
+    double sum = 0;
+    const Level &lower = this->_levels[level - 1];
+    for (int subRow = 2 * row; subRow <= std::min(2 * row + 1, lower.rows - 1);
+            subRow++) {
+        for (int subCol = 2 * col;
+                subCol <= std::min(2 * col + 1, lower.cols - 1); subCol++) {
+            sum += this->sumInCircle(query, level - 1, subRow, subCol);
+        }
+    }
+    return sum;
+}
+
+}  // namespace estnet
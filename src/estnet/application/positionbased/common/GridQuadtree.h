@@ -0,0 +1,89 @@
+//
+// Copyright (C) 2020 Computer Science VII: Robotics and Telematics - 
+// Julius-Maximilians-Universitaet Wuerzburg
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see http://www.gnu.org/licenses/.
+//
+
+
+#ifndef __APPS__GRID_QUADTREE_H__
+#define __APPS__GRID_QUADTREE_H__
+
+#include <vector>
+
+#include "estnet/common/ESTNETDefs.h"
+
+namespace estnet {
+
+/**
+ * Quadtree over a regular grid of values. Every node stores the sum of the
+ * values below it and the number of non-zero values, so sums over a region
+ * only descend into nodes which are cut by the region's border and contain
+ * data. Cells are addressed by their integer row and column, which are also
+ * their coordinates in range queries.
+ */
+class ESTNET_API GridQuadtree {
+public:
+    GridQuadtree(int rows, int cols);
+
+    /** @brief sets the value of a cell, requires ~build before queries */
+    void set(int row, int col, double value);
+    /** @brief returns the value of a cell */
+    double get(int row, int col) const {
+        return this->_levels[0].sum[row * this->_cols + col];
+    }
+    /** @brief (re)builds the inner nodes after the cells were set */
+    void build();
+
+    /**
+     * Sums up all cells (row, col) with minRow <= row <= maxRow and
+     * (row - centerRow)^2 + (col - centerCol)^2 <= radius^2.
+     */
+    double sumInCircle(double centerRow, double centerCol, double radius,
+            int minRow, int maxRow) const;
+
+    int getRows() const {
+        return this->_rows;
+    }
+    int getCols() const {
+        return this->_cols;
+    }
+
+private:
+    struct Level {
+        int rows;
+        int cols;
+        std::vector<double> sum;
+        std::vector<int> nonZero;
+    };
+
+    struct Query {
+        double centerRow;
+        double centerCol;
+        double radius2;
+        int minRow;
+        int maxRow;
+    };
+
+    double sumInCircle(const Query &query, int level, int row, int col) const;
+
+    int _rows;
+    int _cols;
+    // _levels[0] are the cells, the last level is the root
+    std::vector<Level> _levels;
+};
+
+}  // namespace estnet
+
+#endif
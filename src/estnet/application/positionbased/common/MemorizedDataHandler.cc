@@ -35,15 +35,14 @@ using namespace std;
 namespace estnet {
 
 static MemorizedDataHandler *instance;
+static int instanceUsers = 0;
 
 MemorizedDataHandler::~MemorizedDataHandler() {
-    delete &file;
-    delete &dataSet;
-    delete &acquaintedShipMap;
-    delete &messageToSendMap;
-    delete satMobility;
-    delete earthModel;
-    delete instance;
+    // mobility and earth model are owned by the simulation
+    if (instance == this) {
+        instance = nullptr;
+        instanceUsers = 0;
+    }
 }
 
 MemorizedDataHandler* MemorizedDataHandler::getInstance(
@@ -51,9 +50,17 @@ MemorizedDataHandler* MemorizedDataHandler::getInstance(
     if (instance == nullptr) {
         new MemorizedDataHandler(satMobility, earthModel, path);
     }
+    instanceUsers++;
     return instance;
 }
 
+void MemorizedDataHandler::releaseInstance() {
+    if (instance != nullptr && --instanceUsers <= 0) {
+        // deletion resets instance, so the next run starts from scratch
+        delete instance;
+    }
+}
+
 int64_t getCellNumber(double latitude, double longtitude, double resolution) {
     latitude = latitude - std::fmod(latitude, resolution);
     longtitude = longtitude - std::fmod(longtitude, resolution);
@@ -99,7 +106,7 @@ MemorizedDataHandler::MemorizedDataHandler(SatMobility *satMobility,
         IEarthModel *earthModel, std::string path) {
     if (instance == nullptr) {
         // reads data file
-        file.open(path);
+        std::ifstream file(path);
         if (file.is_open()) {
             std::string line;
             if (getline(file, line)) {
@@ -111,7 +118,7 @@ MemorizedDataHandler::MemorizedDataHandler(SatMobility *satMobility,
             // Iterates over all line in File
             double numTransmitter, totalNumOfTransmitters = 0;
             std::string longtitude, latitude, numTransmitterString;
-            int64_t counter, cellNumber = 0;
+            int64_t cellNumber = 0;
             std::size_t longEndPoint, latEndPoint;
             while (getline(file, line)) {
                 latEndPoint = line.find(";");
@@ -124,13 +131,14 @@ MemorizedDataHandler::MemorizedDataHandler(SatMobility *satMobility,
                 numTransmitterString = line.substr(longEndPoint + 1);
                 numTransmitter = std::stod(numTransmitterString);
 
-                counter++;
                 cellNumber = getCellNumber(std::stod(latitude),
                         std::stod(longtitude), resolution);
-                if ((int) dataSet.size() < cellNumber) {
-                    dataSet.resize(cellNumber + 1);
+                // only cells with transmitters are stored
+                if (numTransmitter > 0) {
+                    dataSet[cellNumber] = numTransmitter;
+                } else {
+                    dataSet.erase(cellNumber);
                 }
-                dataSet[cellNumber] = numTransmitter;
                 totalNumOfTransmitters += numTransmitter;
             }
             cout << "MemorizedDataHandler: Total read transmitters: "
@@ -156,15 +164,15 @@ void MemorizedDataHandler::getDataForPoint(double latitude, double longitude,
         double &multiplier) {
     if (numberOfMsgToSend == 0) {
         if (satMobility != nullptr) {
-            messageToSendMap.clear();
+            numMessagesToSend = 0;
             inet::Coord coord = this->satMobility->getCurrentPosition();
             inet::Coord vel = this->satMobility->getCurrentVelocity();
             setDataForPointInAcquaintedShip(coord, vel, latitude, longitude);
 
-            numberOfMsgToSend = this->messageToSendMap.size();
+            numberOfMsgToSend = this->numMessagesToSend;
         }
     } else {
-        multiplier = this->messageToSendMap.size()
+        multiplier = this->numMessagesToSend
                 / calcIdleInterval(latitude, longitude, 0, 0);
         numberOfMsgToSend--;
     }
@@ -174,16 +182,16 @@ void MemorizedDataHandler::getDataForCone(double latitude, double longitude,
         double altitude, double beamWidth, double &multiplier) {
     if (numberOfMsgToSend == 0) {
         if (satMobility != nullptr) {
-            messageToSendMap.clear();
+            numMessagesToSend = 0;
             inet::Coord coord = this->satMobility->getCurrentPosition();
             inet::Coord vel = this->satMobility->getCurrentVelocity();
             setDataForConeInAcquaintedShip(coord, vel, latitude, longitude,
                     altitude, beamWidth);
 
-            numberOfMsgToSend = this->messageToSendMap.size();
+            numberOfMsgToSend = this->numMessagesToSend;
         }
     } else {
-        multiplier = this->messageToSendMap.size()
+        multiplier = this->numMessagesToSend
                 / calcIdleInterval(latitude, longitude, altitude, beamWidth);
         numberOfMsgToSend--;
     }
@@ -318,7 +326,6 @@ void MemorizedDataHandler::setDataForConeInAcquaintedShip(inet::Coord coord,
     double minLong = subDegLongtitude(longitude, longtitudeRadiusInRad);
     double maxLong = sumDegLongtitude(longitude, longtitudeRadiusInRad);
 
-    std::string keyForMap;
     inet::Coord coordShip, vectorSatShip, coordSat, coorNadirSat;
     double sightDuration = 0;
 
@@ -330,9 +337,8 @@ void MemorizedDataHandler::setDataForConeInAcquaintedShip(inet::Coord coord,
     double numColumns = getNumber(minLong, maxLong, resolution);
     double numRows = getNumber(minLat, maxLat, resolution);
 
-    double cellNumber, value, numMessagesRemainder, workLat, workLong = 0;
-
-    int total = 0;
+    double value, numMessagesRemainder = 0, workLat, workLong = 0;
+    int64_t cellNumber;
 
     double roundTime = (2 * PI * (altitude + EARTH_AVG_R))
             / speedCoord.length();
@@ -349,48 +355,22 @@ void MemorizedDataHandler::setDataForConeInAcquaintedShip(inet::Coord coord,
 
             // Continue with the next dataset, if no data exists in the current cell
             // or the data points are more then radiusFootprint away from NadirPoint
-            if (cellNumber >= dataSet.size()
+            auto cellData = dataSet.find(cellNumber);
+            if (cellData == dataSet.end()
                     || coorNadirSat.distance(coordShip)
                             > getFootPrintRadiusInKm(halfBeamWidth)) {
                 continue;
             }
 
-            value = calculateNumOfMessagesToSend(dataSet.at(cellNumber),
+            value = calculateNumOfMessagesToSend(cellData->second,
                     &numMessagesRemainder);
 
-            for (int count = 0; count < value; count++) {
-                keyForMap = "";
-                keyForMap.append(std::to_string(cellNumber));
-                keyForMap.append("_");
-                keyForMap.append(std::to_string(count));
-
-                // Value SIMTIME_ZERO means we have to send a message for this ship.
-                // Logic: Add message to map if: it is unknown or the current time is greater then last hit time + duration of sight
-
-                if (acquaintedShipMap.find(keyForMap)
-                        == acquaintedShipMap.end()) {
-                    acquaintedShipMap.insert(
-                            std::pair<std::string, double>(keyForMap,
-                                    omnetpp::simTime().dbl()));
-                }
-
-                if (acquaintedShipMap.find(keyForMap)->second
-                        <= omnetpp::simTime().dbl()) {
-                    totalDetected++;
-                    total++;
-                    acquaintedShipMap.find(keyForMap)->second =
-                            omnetpp::simTime().dbl() + sightDuration
-                                    + roundTime;
-
-                    if (isShipDetected()) {
-                        messageToSendMap.insert(
-                                std::pair<std::string, omnetpp::simtime_t>(
-                                        keyForMap, SIMTIME_ZERO));
-                    }
-                }
-            }
+            // ships are detected again after this flyover and one orbit
+            numMessagesToSend += detectShipsInCell(cellNumber,
+                    (int) std::ceil(value), sightDuration + roundTime);
         }
     }
+    evictExpiredCells();
 }
 
 void MemorizedDataHandler::setDataForPointInAcquaintedShip(inet::Coord coord,
@@ -405,49 +385,84 @@ void MemorizedDataHandler::setDataForPointInAcquaintedShip(inet::Coord coord,
             inetu::deg(inet::math::deg2rad(latitude)),
             inetu::deg(inet::math::deg2rad(longitude)), inetu::m(10),
             coordShip);
-    double cellNumber, value, numMessagesRemainder = 0;
-    cellNumber = getCellNumber(latitude, longitude, resolution);
+    double value, numMessagesRemainder = 0;
+    int64_t cellNumber = getCellNumber(latitude, longitude, resolution);
 
     // Continue with the next dataset, if no data exists in the current cell
     // or the data points are more then radiusFootprint away from NadirPoint
-    if (cellNumber >= dataSet.size()
+    auto cellData = dataSet.find(cellNumber);
+    if (cellData == dataSet.end()
             || coorNadirSat.distance(coordShip) > resolution) {
         return;
     }
-    value = calculateNumOfMessagesToSend(dataSet.at(cellNumber),
+    value = calculateNumOfMessagesToSend(cellData->second,
             &numMessagesRemainder);
 
-    std::string keyForMap;
-    int total = 0;
-
-    for (int count = 0; count < value; count++) {
-        keyForMap = "";
-        keyForMap.append(std::to_string(cellNumber));
-        keyForMap.append("_");
-        keyForMap.append(std::to_string(count));
-
-        // Value SIMTIME_ZERO means we have to send a message for this ship.
-        // Logic: Add message to map if: it is unknown or the current time is greater then last hit time + duration of sight
+    // ships are detected again at the next check
+    numMessagesToSend += detectShipsInCell(cellNumber, (int) std::ceil(value),
+            0);
+    evictExpiredCells();
+}
 
-        if (acquaintedShipMap.find(keyForMap) == acquaintedShipMap.end()) {
-            acquaintedShipMap.insert(
-                    std::pair<std::string, double>(keyForMap,
-                            omnetpp::simTime().dbl()));
+int MemorizedDataHandler::detectShipsInCell(int64_t cellNumber, int numShips,
+        double redetectionDelay) {
+    if (numShips <= 0) {
+        return 0;
+    }
+    double now = omnetpp::simTime().dbl();
+
+    // Logic: a ship is detected if it is unknown or the current time is
+    // greater then last hit time + duration of sight. Unknown ships are
+    // not stored, they behave like ships that can be detected now.
+    auto it = acquaintedCells.find(cellNumber);
+    if (it == acquaintedCells.end()) {
+        if (redetectionDelay <= 0) {
+            // ships would be detectable right away again, nothing to memorize
+            int detected = 0;
+            for (int count = 0; count < numShips; count++) {
+                totalDetected++;
+                if (isShipDetected()) {
+                    detected++;
+                }
+            }
+            return detected;
         }
-
-        if (acquaintedShipMap.find(keyForMap)->second
-                <= omnetpp::simTime().dbl()) {
+        it = acquaintedCells.emplace(cellNumber, CellMemory()).first;
+    }
+    CellMemory &cell = it->second;
+    if ((int) cell.nextDetection.size() < numShips) {
+        cell.nextDetection.resize(numShips, now);
+    }
+    int detected = 0;
+    for (int count = 0; count < numShips; count++) {
+        if (cell.nextDetection[count] <= now) {
             totalDetected++;
-            total++;
-            acquaintedShipMap.find(keyForMap)->second = omnetpp::simTime().dbl();
-
+            cell.nextDetection[count] = now + redetectionDelay;
+            cell.latest = std::max(cell.latest, cell.nextDetection[count]);
             if (isShipDetected()) {
-                messageToSendMap.insert(
-                        std::pair<std::string, omnetpp::simtime_t>(keyForMap,
-                                SIMTIME_ZERO));
+                detected++;
             }
         }
     }
+    return detected;
+}
+
+void MemorizedDataHandler::evictExpiredCells() {
+    // sweep only after the map has grown considerably since the last sweep,
+    // which keeps the cost per memorized cell constant
+    if (acquaintedCells.size() < 2 * cellsAfterEviction + 1024) {
+        return;
+    }
+    // a cell whose ships can all be detected again behaves like an unknown one
+    double now = omnetpp::simTime().dbl();
+    for (auto it = acquaintedCells.begin(); it != acquaintedCells.end();) {
+        if (it->second.latest <= now) {
+            it = acquaintedCells.erase(it);
+        } else {
+            ++it;
+        }
+    }
+    cellsAfterEviction = acquaintedCells.size();
 }
 
 }  // namespace estnet
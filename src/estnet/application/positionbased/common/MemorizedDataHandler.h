@@ -19,7 +19,10 @@
 #ifndef __APPS__MEMORIZED_DATA_HANDLER_H__
 #define __APPS__MEMORIZED_DATA_HANDLER_H__
 
+#include <cstdint>
 #include <fstream>
+#include <unordered_map>
+#include <vector>
 
 #include <inet/common/geometry/common/Coord.h>
 
@@ -54,19 +57,52 @@ public:
             double altitude, double beamWidth);
     virtual double calcIdleInterval(double latitude, double longitude,
             double altitude, double beamWidth);
+    /** @brief returns the shared instance, creates it on first use.
+     *  Every call has to be matched by a call of releaseInstance() */
     static MemorizedDataHandler* getInstance(SatMobility *satMobility,
             IEarthModel *earthModel, std::string path);
+    /** @brief releases the shared instance, which is deleted
+     *  once no user is left */
+    static void releaseInstance();
+
+    /** @brief returns the number of cells with memorized ships */
+    size_t getNumMemorizedCells() const {
+        return this->acquaintedCells.size();
+    }
 
 private:
-    std::vector<double> dataSet;
-    std::ifstream file;
+    /** memorized ships of one cell, indexed by the number of the ship in the cell */
+    struct CellMemory {
+        // latest time in nextDetection, the cell can be evicted after it
+        double latest = 0;
+        // time from which on each ship is detected again
+        std::vector<double> nextDetection;
+    };
+
+    /**
+     * Checks which ships of a cell are detected now and memorizes them.
+     * Ships are never memorized beyond the number of transmitters in the cell.
+     * @param cellNumber: cell to check
+     * @param numShips: number of ships in the cell
+     * @param redetectionDelay: time after which a detected ship is detected again
+     * @return number of newly detected ships
+     */
+    int detectShipsInCell(int64_t cellNumber, int numShips,
+            double redetectionDelay);
+    /** @brief removes cells whose ships would all be detected again */
+    void evictExpiredCells();
+
+    // number of transmitters in each cell that has any
+    std::unordered_map<int64_t, double> dataSet;
     double resolution;
     int totalDetected = 0;
-    // List of known ships per satellite. KEY = 'Lat_Lon_Number'. VALUE = transmission time + duration of this flyover
+    // Known ships per cell, only cells with ships not to be detected again yet
     // Logic: Transmit only once data for each ship during each orbit
-    std::map<std::string, double> acquaintedShipMap;
-    // List of the messages to send during current orbit. KEY = 'Lat_Lon_Number'. VALUE = duration of this flyover
-    std::map<std::string, omnetpp::simtime_t> messageToSendMap;
+    std::unordered_map<int64_t, CellMemory> acquaintedCells;
+    // size of acquaintedCells after the last eviction
+    size_t cellsAfterEviction = 0;
+    // number of messages to send during the current orbit
+    int numMessagesToSend = 0;
     SatMobility *satMobility = nullptr; // SatMobility module as position source
     IEarthModel *earthModel;
     int numberOfMsgToSend;
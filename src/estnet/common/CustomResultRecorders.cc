@@ -0,0 +1,144 @@
+//
+// Copyright (C) 2020 Computer Science VII: Robotics and Telematics - 
+// Julius-Maximilians-Universitaet Wuerzburg
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see http://www.gnu.org/licenses/.
+//
+
+
+#include "CustomResultRecorders.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace estnet {
+
+P2QuantileEstimator::P2QuantileEstimator(double p) :
+        _p(p) {
+    if (p < 0 || p > 1) {
+        throw omnetpp::cRuntimeError("Quantile %g out of range [0, 1]", p);
+    }
+}
+
+void P2QuantileEstimator::collect(double value) {
+    if (this->_count < 5) {
+        this->_q[this->_count++] = value;
+        if (this->_count == 5) {
+            std::sort(this->_q, this->_q + 5);
+            const double p = this->_p;
+            for (int i = 0; i < 5; i++) {
+                this->_n[i] = i;
+            }
+            this->_np[0] = 0;
+            this->_np[1] = 2 * p;
+            this->_np[2] = 4 * p;
+            this->_np[3] = 2 + 2 * p;
+            this->_np[4] = 4;
+            this->_dn[0] = 0;
+            this->_dn[1] = p / 2;
+            this->_dn[2] = p;
+            this->_dn[3] = (1 + p) / 2;
+            this->_dn[4] = 1;
+        }
+        return;
+    }
+    this->_count++;
+
+    // find the cell of the new value and adjust the extreme markers
+    int k;
+    if (value < this->_q[0]) {
+        this->_q[0] = value;
+        k = 0;
+    } else if (value >= this->_q[4]) {
+        this->_q[4] = value;
+        k = 3;
+    } else {
+        k = 0;
+        while (value >= this->_q[k + 1]) {
+            k++;
+        }
+    }
+    for (int i = k + 1; i < 5; i++) {
+        this->_n[i]++;
+    }
+    for (int i = 0; i < 5; i++) {
+        this->_np[i] += this->_dn[i];
+    }
+
+    // move the inner markers towards their desired positions
+    for (int i = 1; i < 4; i++) {
+        double d = this->_np[i] - this->_n[i];
+        if ((d >= 1 && this->_n[i + 1] - this->_n[i] > 1)
+                || (d <= -1 && this->_n[i - 1] - this->_n[i] < -1)) {
+            int s = d > 0 ? 1 : -1;
+            // piecewise parabolic prediction
+            double q = this->_q[i]
+                    + s / (this->_n[i + 1] - this->_n[i - 1])
+                            * ((this->_n[i] - this->_n[i - 1] + s)
+                                    * (this->_q[i + 1] - this->_q[i])
+                                    / (this->_n[i + 1] - this->_n[i])
+                                    + (this->_n[i + 1] - this->_n[i] - s)
+                                            * (this->_q[i] - this->_q[i - 1])
+                                            / (this->_n[i] - this->_n[i - 1]));
+            if (this->_q[i - 1] < q && q < this->_q[i + 1]) {
+                this->_q[i] = q;
+            } else {
+                // fall back to linear prediction
+                this->_q[i] += s * (this->_q[i + s] - this->_q[i])
+                        / (this->_n[i + s] - this->_n[i]);
+            }
+            this->_n[i] += s;
+        }
+    }
+}
+
+double P2QuantileEstimator::getQuantile() const {
+    if (this->_count == 0) {
+        return NAN;
+    }
+    if (this->_count <= 5) {
+        // too few values for the markers, use the exact quantile
+        double sorted[5];
+        std::copy(this->_q, this->_q + this->_count, sorted);
+        std::sort(sorted, sorted + this->_count);
+        size_t index = (size_t) std::round(this->_p * (this->_count - 1));
+        return sorted[index];
+    }
+    return this->_q[2];
+}
+
+QuantilesRecorder::QuantilesRecorder() :
+        _median(0.5), _p95(0.95), _p99(0.99) {
+}
+
+void QuantilesRecorder::collect(omnetpp::simtime_t_cref t, double value,
+        omnetpp::cObject *details) {
+    this->_median.collect(value);
+    this->_p95.collect(value);
+    this->_p99.collect(value);
+}
+
+void QuantilesRecorder::finish(omnetpp::cResultFilter *prev) {
+    omnetpp::opp_string_map attributes = getStatisticAttributes();
+    std::string name = getStatisticName();
+    omnetpp::getEnvir()->recordScalar(getComponent(), (name + ":p50").c_str(),
+            this->_median.getQuantile(), &attributes);
+    omnetpp::getEnvir()->recordScalar(getComponent(), (name + ":p95").c_str(),
+            this->_p95.getQuantile(), &attributes);
+    omnetpp::getEnvir()->recordScalar(getComponent(), (name + ":p99").c_str(),
+            this->_p99.getQuantile(), &attributes);
+}
+Register_ResultRecorder("quantiles", QuantilesRecorder);
+
+}  // namespace estnet
@@ -0,0 +1,77 @@
+//
+// Copyright (C) 2020 Computer Science VII: Robotics and Telematics - 
+// Julius-Maximilians-Universitaet Wuerzburg
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see http://www.gnu.org/licenses/.
+//
+
+
+#ifndef __UTILS_CUSTOM_RESULT_RECORDERS_H__
+#define __UTILS_CUSTOM_RESULT_RECORDERS_H__
+
+#include "ESTNETDefs.h"
+
+namespace estnet {
+
+/**
+ * Streaming estimator of a single quantile using the P-square algorithm
+ * (Jain and Chlamtac, 1985). Uses constant memory independent of the
+ * number of observations.
+ */
+class ESTNET_API P2QuantileEstimator {
+public:
+    explicit P2QuantileEstimator(double p);
+
+    /** @brief adds an observation */
+    void collect(double value);
+    /** @brief returns the current estimate of the quantile */
+    double getQuantile() const;
+    /** @brief returns the number of observations */
+    unsigned long getCount() const {
+        return this->_count;
+    }
+
+private:
+    double _p;
+    unsigned long _count = 0;
+    // marker heights, actual and desired marker positions
+    double _q[5];
+    double _n[5];
+    double _np[5];
+    double _dn[5];
+};
+
+/**
+ * Result recorder that records the median, 95th and 99th percentile of
+ * the recorded values as scalars, estimated online without keeping the
+ * values. Use as "quantiles" in the record list of a statistic.
+ */
+class ESTNET_API QuantilesRecorder: public omnetpp::cNumericResultRecorder {
+public:
+    QuantilesRecorder();
+
+protected:
+    virtual void collect(omnetpp::simtime_t_cref t, double value,
+            omnetpp::cObject *details) override;
+    virtual void finish(omnetpp::cResultFilter *prev) override;
+
+private:
+    P2QuantileEstimator _median;
+    P2QuantileEstimator _p95;
+    P2QuantileEstimator _p99;
+};
+
+}  // namespace estnet
+
+#endif
@@ -0,0 +1,129 @@
+//
+// Copyright (C) 2020 Computer Science VII: Robotics and Telematics - 
+// Julius-Maximilians-Universitaet Wuerzburg
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see http://www.gnu.org/licenses/.
+//
+
+
+#include "FileUtils.h"
+
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <sys/stat.h>
+#if defined(_WIN32)
+#include <process.h>
+#define getpid _getpid
+#else
+#include <unistd.h>
+#endif
+
+namespace estnet {
+
+bool getFileStamp(const std::string &path, int64_t &size, int64_t &modified) {
+    struct stat info;
+    if (stat(path.c_str(), &info) != 0) {
+        return false;
+    }
+    size = info.st_size;
+    modified = info.st_mtime;
+    return true;
+}
+
+std::string getCachePath(const std::string &path,
+        const std::string &cacheDirectory) {
+    if (cacheDirectory.empty()) {
+        return path + ".cache";
+    }
+    // data files with the same name in different directories get their own cache
+    size_t nameStart = path.find_last_of("/\\");
+    std::string name =
+            nameStart == std::string::npos ? path : path.substr(nameStart + 1);
+    std::ostringstream cachePath;
+    cachePath << cacheDirectory;
+    if (cacheDirectory.back() != '/' && cacheDirectory.back() != '\\') {
+        cachePath << '/';
+    }
+    cachePath << name << '.' << std::hex << std::hash<std::string>()(path)
+            << ".cache";
+    return cachePath.str();
+}
+
+bool writeFileAtomically(const std::string &path,
+        const std::function<void(std::ostream&)> &write) {
+    // unique per process, so concurrent runs don't write the same file
+    std::ostringstream tempPath;
+    tempPath << path << ".tmp" << getpid();
+    {
+        std::ofstream file(tempPath.str(), std::ios::binary | std::ios::trunc);
+        if (!file.is_open()) {
+            return false;
+        }
+        write(file);
+        file.close();
+        if (!file) {
+            std::remove(tempPath.str().c_str());
+            return false;
+        }
+    }
+    if (std::rename(tempPath.str().c_str(), path.c_str()) != 0) {
+        // rename does not replace existing files on all platforms
+        std::remove(path.c_str());
+        if (std::rename(tempPath.str().c_str(), path.c_str()) != 0) {
+            std::remove(tempPath.str().c_str());
+            return false;
+        }
+    }
+    return true;
+}
+
+bool writeCacheHeader(std::ostream &cache, const char *magic,
+        const std::string &path) {
+    int64_t size, modified;
+    if (!getFileStamp(path, size, modified)) {
+        cache.setstate(std::ios::failbit);
+        return false;
+    }
+    cache.write(magic, CACHE_MAGIC_SIZE);
+    cache.write(reinterpret_cast<const char*>(&size), sizeof(size));
+    cache.write(reinterpret_cast<const char*>(&modified), sizeof(modified));
+    return static_cast<bool>(cache);
+}
+
+bool readCacheHeader(std::istream &cache, const char *magic,
+        const std::string &path, int64_t &remaining) {
+    int64_t size, modified;
+    if (!getFileStamp(path, size, modified)) {
+        return false;
+    }
+    char cachedMagic[CACHE_MAGIC_SIZE];
+    int64_t cachedSize, cachedModified;
+    cache.read(cachedMagic, sizeof(cachedMagic));
+    cache.read(reinterpret_cast<char*>(&cachedSize), sizeof(cachedSize));
+    cache.read(reinterpret_cast<char*>(&cachedModified),
+            sizeof(cachedModified));
+    if (!cache || std::memcmp(cachedMagic, magic, CACHE_MAGIC_SIZE) != 0
+            || cachedSize != size || cachedModified != modified) {
+        return false;
+    }
+    std::streampos position = cache.tellg();
+    cache.seekg(0, std::ios::end);
+    remaining = cache.tellg() - position;
+    cache.seekg(position);
+    return static_cast<bool>(cache);
+}
+
+}  // namespace estnet
@@ -0,0 +1,81 @@
+//
+// Copyright (C) 2020 Computer Science VII: Robotics and Telematics - 
+// Julius-Maximilians-Universitaet Wuerzburg
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see http://www.gnu.org/licenses/.
+//
+
+
+#ifndef __ESTNET__FILE_UTILS_H__
+#define __ESTNET__FILE_UTILS_H__
+
+#include <cstdint>
+#include <functional>
+#include <istream>
+#include <ostream>
+#include <string>
+
+#include "estnet/common/ESTNETDefs.h"
+
+namespace estnet {
+
+/**
+ * Returns size and modification time of a file, used to tell whether a
+ * cache derived from the file is outdated.
+ * @return false if the file does not exist
+ */
+bool ESTNET_API getFileStamp(const std::string &path, int64_t &size,
+        int64_t &modified);
+
+/**
+ * Returns the path of the cache derived from a data file. The cache is kept
+ * next to the data file if cacheDirectory is empty, otherwise in the
+ * existing cacheDirectory, named after the data file and a hash of its path.
+ */
+std::string ESTNET_API getCachePath(const std::string &path,
+        const std::string &cacheDirectory);
+
+/**
+ * Writes a file to a temporary file next to it first and renames that
+ * into place, so a reader never sees a partially written file.
+ * @param write: writes the content, nothing is replaced if the stream fails
+ * @return false if the file could not be written
+ */
+bool ESTNET_API writeFileAtomically(const std::string &path,
+        const std::function<void(std::ostream&)> &write);
+
+/** number of bytes of the magic identifying the format of a binary cache */
+const size_t CACHE_MAGIC_SIZE = 8;
+
+/**
+ * Writes the header of a binary cache derived from a data file, the magic
+ * of the cache format followed by the size and modification time of the
+ * data file.
+ * @return false, with the stream failed, if the data file does not exist
+ */
+bool ESTNET_API writeCacheHeader(std::ostream &cache, const char *magic,
+        const std::string &path);
+
+/**
+ * Reads and checks the header written by writeCacheHeader.
+ * @param remaining: set to the number of bytes after the header, so the
+ * content can be checked before it is allocated
+ * @return false if the cache has another format or the data file changed
+ */
+bool ESTNET_API readCacheHeader(std::istream &cache, const char *magic,
+        const std::string &path, int64_t &remaining);
+
+}  // namespace estnet
+
+#endif // __ESTNET__FILE_UTILS_H__
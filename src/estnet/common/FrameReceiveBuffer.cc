@@ -0,0 +1,102 @@
+//
+// Copyright (C) 2020 Computer Science VII: Robotics and Telematics - 
+// Julius-Maximilians-Universitaet Wuerzburg
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see http://www.gnu.org/licenses/.
+//
+
+
+#include "FrameReceiveBuffer.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace estnet {
+
+FrameReceiveBuffer::FrameReceiveBuffer(size_t initialCapacity) :
+        _buffer(initialCapacity + 1) {
+}
+
+char* FrameReceiveBuffer::prepareWrite(size_t minFree, size_t &available) {
+    this->restoreTerminatedByte();
+    // move the remaining bytes to the front, so the buffer does not grow
+    if (this->_readPos > 0) {
+        size_t remaining = this->_writePos - this->_readPos;
+        if (remaining > 0) {
+            memmove(&this->_buffer[0], &this->_buffer[this->_readPos],
+                    remaining);
+        }
+        this->_readPos = 0;
+        this->_writePos = remaining;
+    }
+    // always keep one byte spare to terminate a frame at the end
+    if (this->_buffer.size() < this->_writePos + minFree + 1) {
+        this->_buffer.resize(
+                std::max(2 * this->_buffer.size(),
+                        this->_writePos + minFree + 1));
+    }
+    available = this->_buffer.size() - this->_writePos - 1;
+    return &this->_buffer[this->_writePos];
+}
+
+void FrameReceiveBuffer::commitWrite(size_t numBytes) {
+    this->_writePos += numBytes;
+}
+
+bool FrameReceiveBuffer::hasFrame() const {
+    size_t buffered = this->getBufferedBytes();
+    if (buffered < 2) {
+        return false;
+    }
+    // the first byte of the prefix might be replaced by the last terminator
+    unsigned char high =
+            this->_terminated && this->_terminatorPos == this->_readPos ?
+                    this->_terminatedByte : this->_buffer[this->_readPos];
+    unsigned char low = this->_buffer[this->_readPos + 1];
+    size_t length = (high << 8) + low;
+    return buffered >= 2 + length;
+}
+
+bool FrameReceiveBuffer::nextFrame(char *&frame, size_t &length) {
+    this->restoreTerminatedByte();
+    if (!this->hasFrame()) {
+        return false;
+    }
+    const unsigned char *prefix =
+            (const unsigned char*) &this->_buffer[this->_readPos];
+    length = (prefix[0] << 8) + prefix[1];
+    frame = &this->_buffer[this->_readPos + 2];
+    this->_readPos += 2 + length;
+    // terminate in place, the overwritten byte might belong to the next frame
+    this->_terminatorPos = this->_readPos;
+    this->_terminatedByte = this->_buffer[this->_terminatorPos];
+    this->_buffer[this->_terminatorPos] = '\0';
+    this->_terminated = true;
+    return true;
+}
+
+void FrameReceiveBuffer::clear() {
+    this->_readPos = 0;
+    this->_writePos = 0;
+    this->_terminated = false;
+}
+
+void FrameReceiveBuffer::restoreTerminatedByte() {
+    if (this->_terminated) {
+        this->_buffer[this->_terminatorPos] = this->_terminatedByte;
+        this->_terminated = false;
+    }
+}
+
+}  // namespace estnet
@@ -0,0 +1,89 @@
+//
+// Copyright (C) 2020 Computer Science VII: Robotics and Telematics - 
+// Julius-Maximilians-Universitaet Wuerzburg
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see http://www.gnu.org/licenses/.
+//
+
+
+#ifndef __UTILS_FRAME_RECEIVE_BUFFER_H__
+#define __UTILS_FRAME_RECEIVE_BUFFER_H__
+
+#include <cstddef>
+#include <vector>
+
+#include "estnet/common/ESTNETDefs.h"
+
+namespace estnet {
+
+/**
+ * Receive buffer for frames with a 16-bit big endian length prefix,
+ * as used on the TCP and serial interfaces to external processes.
+ * The buffer is kept for the whole lifetime of a connection, so reads
+ * can go directly into it without clearing memory, partially received
+ * frames are kept until the rest arrives and a single read may contain
+ * several frames. Frames are null terminated in place, so they can be
+ * parsed in situ.
+ */
+class ESTNET_API FrameReceiveBuffer {
+public:
+    /** maximum length of a frame, limited by the length prefix */
+    static const size_t MAX_FRAME_LENGTH = 0xFFFF;
+
+    explicit FrameReceiveBuffer(size_t initialCapacity = 4096);
+
+    /**
+     * Returns the memory to read new bytes into, which has at least
+     * minFree bytes. Invalidates frames returned by ~nextFrame.
+     * @param minFree: minimum number of bytes to read at once
+     * @param available: set to the number of bytes that may be written
+     * @return pointer to write the received bytes to
+     */
+    char* prepareWrite(size_t minFree, size_t &available);
+    /** @brief marks numBytes written after ~prepareWrite as received */
+    void commitWrite(size_t numBytes);
+
+    /**
+     * Extracts the next completely received frame.
+     * @param frame: set to the null terminated frame content, which may be
+     *               modified and stays valid until the next call
+     * @param length: set to the length of the frame without terminator
+     * @return true if a complete frame was available
+     */
+    bool nextFrame(char *&frame, size_t &length);
+    /** @brief checks whether a complete frame is available */
+    bool hasFrame() const;
+    /** @brief returns the number of received bytes not yet extracted */
+    size_t getBufferedBytes() const {
+        return this->_writePos - this->_readPos;
+    }
+    /** @brief drops all buffered bytes */
+    void clear();
+
+private:
+    /** @brief restores the byte overwritten by the terminator of the last frame */
+    void restoreTerminatedByte();
+
+    std::vector<char> _buffer;
+    size_t _readPos = 0;
+    size_t _writePos = 0;
+    // position and original value of the byte replaced by a terminator
+    size_t _terminatorPos = 0;
+    char _terminatedByte = 0;
+    bool _terminated = false;
+};
+
+}  // namespace estnet
+
+#endif
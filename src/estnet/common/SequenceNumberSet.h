@@ -0,0 +1,125 @@
+//
+// Copyright (C) 2020 Computer Science VII: Robotics and Telematics - 
+// Julius-Maximilians-Universitaet Wuerzburg
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see http://www.gnu.org/licenses/.
+//
+
+
+#ifndef __UTILS_SEQUENCE_NUMBER_SET_H__
+#define __UTILS_SEQUENCE_NUMBER_SET_H__
+
+#include <map>
+
+#include "estnet/common/ESTNETDefs.h"
+
+namespace estnet {
+
+/**
+ * Set of sequence numbers stored as disjoint, non adjacent intervals.
+ * Sequence numbers that mostly arrive in order collapse into a few
+ * intervals, so the memory only grows with the number of gaps and not
+ * with the number of sequence numbers.
+ */
+class ESTNET_API SequenceNumberSet {
+public:
+    typedef unsigned long tSequenceNumber;
+
+    /**
+     * Adds a sequence number to the set.
+     * @return false if it was already contained
+     */
+    bool insert(tSequenceNumber seq) {
+        // first interval starting after seq
+        auto next = this->_intervals.upper_bound(seq);
+        if (next != this->_intervals.begin()) {
+            auto prev = std::prev(next);
+            if (seq <= prev->second) {
+                return false;
+            }
+            if (prev->second + 1 == seq) {
+                prev->second = seq;
+                // close the gap to the following interval
+                if (next != this->_intervals.end() && next->first == seq + 1) {
+                    prev->second = next->second;
+                    this->_intervals.erase(next);
+                }
+                this->_size++;
+                return true;
+            }
+        }
+        if (next != this->_intervals.end() && next->first == seq + 1) {
+            tSequenceNumber last = next->second;
+            this->_intervals.erase(next);
+            this->_intervals.emplace(seq, last);
+        } else {
+            this->_intervals.emplace(seq, seq);
+        }
+        this->_size++;
+        return true;
+    }
+
+    /** @brief checks whether the sequence number is in the set */
+    bool contains(tSequenceNumber seq) const {
+        auto next = this->_intervals.upper_bound(seq);
+        if (next == this->_intervals.begin()) {
+            return false;
+        }
+        return seq <= std::prev(next)->second;
+    }
+
+    /**
+     * Calls fn for every sequence number in [0, end) which is not in the
+     * set, in ascending order.
+     */
+    template<typename F>
+    void forEachMissing(tSequenceNumber end, F fn) const {
+        tSequenceNumber seq = 0;
+        for (const auto &interval : this->_intervals) {
+            for (; seq < interval.first && seq < end; seq++) {
+                fn(seq);
+            }
+            if (interval.second >= end) {
+                return;
+            }
+            seq = interval.second + 1;
+        }
+        for (; seq < end; seq++) {
+            fn(seq);
+        }
+    }
+
+    /** @brief returns the number of sequence numbers in the set */
+    unsigned long size() const {
+        return this->_size;
+    }
+    /** @brief returns the number of stored intervals */
+    size_t getNumIntervals() const {
+        return this->_intervals.size();
+    }
+    /** @brief removes all sequence numbers */
+    void clear() {
+        this->_intervals.clear();
+        this->_size = 0;
+    }
+
+private:
+    // first -> last sequence number of each interval
+    std::map<tSequenceNumber, tSequenceNumber> _intervals;
+    unsigned long _size = 0;
+};
+
+}  // namespace estnet
+
+#endif
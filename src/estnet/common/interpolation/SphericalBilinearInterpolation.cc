@@ -17,10 +17,12 @@
 //
 
 #include <cmath>
+#include <cstdint>
 #include <fstream>
 #include <sstream>
 #include <stdexcept>
 
+#include <estnet/common/FileUtils.h>
 #include <estnet/common/StrUtil.h>
 
 #include "SphericalBilinearInterpolation.h"
@@ -94,6 +96,78 @@ void SphericalBilinearInterpolation::load(const std::string &path) {
     delta_lon = lon_period / N_lon;
 }
 
+// identifies the binary cache format
+static const char CACHE_MAGIC[estnet::CACHE_MAGIC_SIZE] = { 'E', 'S', 'T', 'S',
+        'B', 'I', '0', '1' };
+
+void SphericalBilinearInterpolation::load_cached(const std::string &path) {
+    std::string cache_path = estnet::getCachePath(path, "");
+    if (load_binary(cache_path, path))
+        return;
+    load(path);
+    save_binary(cache_path, path);
+}
+
+bool SphericalBilinearInterpolation::load_binary(const std::string &cache_path,
+        const std::string &path) {
+    std::ifstream f(cache_path, std::ios::binary);
+    int64_t remaining;
+    if (!f || !estnet::readCacheHeader(f, CACHE_MAGIC, path, remaining))
+        return false;
+    uint64_t n_lat, n_lon;
+    double header[4];
+    f.read(reinterpret_cast<char*>(header), sizeof(header));
+    f.read(reinterpret_cast<char*>(&n_lat), sizeof(n_lat));
+    f.read(reinterpret_cast<char*>(&n_lon), sizeof(n_lon));
+    if (!f || n_lat < 2 || n_lon < 1)
+        return false;
+    // the grid size must match the file before anything is allocated,
+    // so a corrupt cache can neither overflow the size nor exhaust memory
+    uint64_t value_bytes = remaining - sizeof(header) - sizeof(n_lat)
+            - sizeof(n_lon);
+    if (value_bytes % sizeof(double) != 0
+            || n_lat > value_bytes / sizeof(double) / n_lon
+            || n_lat * n_lon != value_bytes / sizeof(double))
+        return false;
+    std::vector<double> cached_values(n_lat * n_lon);
+    f.read(reinterpret_cast<char*>(cached_values.data()),
+            cached_values.size() * sizeof(double));
+    if (!f)
+        return false;
+    min_lat = header[0];
+    max_lat = header[1];
+    lon_period = header[2];
+    lon_offset = header[3];
+    N_lat = n_lat;
+    N_lon = n_lon;
+    values.swap(cached_values);
+    delta_lat = (max_lat - min_lat) / (N_lat - 1);
+    delta_lon = lon_period / N_lon;
+    return true;
+}
+
+void SphericalBilinearInterpolation::save_binary(const std::string &cache_path,
+        const std::string &path) const {
+    uint64_t n_lat = N_lat, n_lon = N_lon;
+    double header[4] = { min_lat, max_lat, lon_period, lon_offset };
+    // a cache that cannot be written (e.g. read-only directory) is skipped
+    estnet::writeFileAtomically(cache_path, [&](std::ostream &f) {
+        if (!estnet::writeCacheHeader(f, CACHE_MAGIC, path))
+            return;
+        f.write(reinterpret_cast<const char*>(header), sizeof(header));
+        f.write(reinterpret_cast<const char*>(&n_lat), sizeof(n_lat));
+        f.write(reinterpret_cast<const char*>(&n_lon), sizeof(n_lon));
+        f.write(reinterpret_cast<const char*>(values.data()),
+                values.size() * sizeof(double));
+    });
+}
+
+void SphericalBilinearInterpolation::apply(
+        const std::function<double(double)> &f) {
+    for (auto &x : values)
+        x = f(x);
+}
+
 double SphericalBilinearInterpolation::get_value(const size_t n,
         const size_t m) const {
     if (!((0 <= n) && (n < N_lat) && (0 <= m) && (m < N_lon)))
@@ -103,8 +177,25 @@ double SphericalBilinearInterpolation::get_value(const size_t n,
 
 double SphericalBilinearInterpolation::get(const double lat,
         const double lon) const {
-    // latitude
+    Cell cell;
+    return get(lat, lon, cell);
+}
+
+double SphericalBilinearInterpolation::get(const double lat, const double lon,
+        Cell &cell) const {
     const double y = (lat - min_lat) / delta_lat;
+    const double x = (lon - lon_offset) / delta_lon;
+    if (cell.valid && cell.y0 <= y && y < cell.y0 + 1 && cell.x0 <= x
+            && x < cell.x0 + 1) {
+        // still inside the previous cell
+        const double fy = y - cell.y0;
+        const double fx = x - cell.x0;
+        return (values[cell.n_m] * (1 - fx) + values[cell.n_mp1] * fx)
+                * (1 - fy)
+                + (values[cell.np1_m] * (1 - fx) + values[cell.np1_mp1] * fx)
+                        * fy;
+    }
+    // latitude
     size_t n, np1;
     double fy;
     if (y < 0) {
@@ -121,27 +212,35 @@ double SphericalBilinearInterpolation::get(const double lat,
         fy = y - n;
     }
     // longitude
-    double x = (lon - lon_offset) / delta_lon;
     // true modulus calculation:
-    x -= N_lon * std::floor(x / N_lon);
-    if (x >= N_lon)
-        x = 0;
+    double xw = x - N_lon * std::floor(x / N_lon);
+    if (xw >= N_lon)
+        xw = 0;
     size_t m, mp1;
-    m = std::floor(x);
+    m = std::floor(xw);
     mp1 = m + 1;
     if (mp1 == N_lon)
         mp1 = 0;
-    double fx = x - m;
+    double fx = xw - m;
 #ifndef NDEBUG
     if (!((0 <= fx) && (fx < 1.0)))
         throw std::runtime_error("out of range: fx");
     if (!((0 <= fy) && (fy < 1.0)))
         throw std::runtime_error("out of range: fy");
 #endif
-    double result = (get_value(n, m) * (1 - fx) + get_value(n, mp1) * fx)
+    cell.n_m = N_lon * n + m;
+    cell.n_mp1 = N_lon * n + mp1;
+    cell.np1_m = N_lon * np1 + m;
+    cell.np1_mp1 = N_lon * np1 + mp1;
+    // positions beyond the latitude range are clamped, so the cell can only
+    // be reused inside the grid
+    cell.valid = np1 != n;
+    cell.y0 = n;
+    cell.x0 = x - fx;
+    double result = (values[cell.n_m] * (1 - fx) + values[cell.n_mp1] * fx)
             * (1 - fy);
     if (fy > 0)
-        result += (get_value(np1, m) * (1 - fx) + get_value(np1, mp1) * fx)
+        result += (values[cell.np1_m] * (1 - fx) + values[cell.np1_mp1] * fx)
                 * fy;
     return result;
 }
@@ -20,6 +20,7 @@
 #ifndef __SPHERICAL_BILINEAR_INTERPOLATION_H__
 #define __SPHERICAL_BILINEAR_INTERPOLATION_H__
 
+#include <functional>
 #include <string>
 #include <vector>
 
@@ -41,13 +42,45 @@
 */
 class SphericalBilinearInterpolation {
 public:
+    /**
+     * Grid cell of the last interpolated position, lets nearby positions
+     * skip the cell computation
+     */
+    struct Cell {
+        bool valid = false;
+        // grid coordinates of the lower corner, before wrapping the longitude
+        double y0 = 0;
+        double x0 = 0;
+        // offsets of the four corner values
+        size_t n_m = 0;
+        size_t n_mp1 = 0;
+        size_t np1_m = 0;
+        size_t np1_mp1 = 0;
+    };
+
     SphericalBilinearInterpolation();
     SphericalBilinearInterpolation(const std::string &path);
     void load(const std::string &path);
+    /**
+     * Like ~load, but keeps the parsed grid in a binary file `path`.cache
+     * and reads that instead as long as the text file is unchanged
+     */
+    void load_cached(const std::string &path);
+    /** applies a function to all grid values, e.g. to convert units */
+    void apply(const std::function<double(double)> &f);
     double get(const double lat, const double lon) const;
+    /**
+     * Like ~get, but reuses the cell if the position is still inside it,
+     * otherwise the cell is updated
+     */
+    double get(const double lat, const double lon, Cell &cell) const;
     double get_value(const size_t n, const size_t m) const;
 
 private:
+    bool load_binary(const std::string &cache_path, const std::string &path);
+    void save_binary(const std::string &cache_path,
+            const std::string &path) const;
+
     double min_lat;
     double max_lat;
     double lon_period;
@@ -0,0 +1,147 @@
+//
+// Copyright (C) 2020 Computer Science VII: Robotics and Telematics - 
+// Julius-Maximilians-Universitaet Wuerzburg
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see http://www.gnu.org/licenses/.
+//
+
+
+#ifndef __UTILS_INDEXED_HEAP_H__
+#define __UTILS_INDEXED_HEAP_H__
+
+#include <cstddef>
+#include <functional>
+#include <utility>
+#include <vector>
+
+namespace estnet {
+
+/** a binary min heap of entries identified by a dense index,
+ * which allows to change or remove the entry of an index
+ * in logarithmic time
+ */
+template <typename Priority, typename Compare = std::less<Priority>> class IndexedHeap {
+public:
+  static const size_t NPOS = (size_t)-1;
+
+  explicit IndexedHeap(Compare compare = Compare()) : _compare{std::move(compare)} {}
+
+  /** @brief inserts the index with the given priority or changes its priority */
+  void set(size_t index, const Priority &priority) {
+    if (index >= _positions.size()) {
+      _positions.resize(index + 1, (size_t)NPOS);
+    }
+    size_t pos = _positions[index];
+    if (pos == NPOS) {
+      pos = _heap.size();
+      _heap.emplace_back(priority, index);
+      _positions[index] = pos;
+      siftUp(pos);
+    } else {
+      _heap[pos].first = priority;
+      siftDown(siftUp(pos));
+    }
+  }
+  /** @brief removes the index from the heap if it is contained */
+  void remove(size_t index) {
+    if (!contains(index)) {
+      return;
+    }
+    size_t pos = _positions[index];
+    swapEntries(pos, _heap.size() - 1);
+    _heap.pop_back();
+    _positions[index] = NPOS;
+    if (pos < _heap.size()) {
+      siftDown(siftUp(pos));
+    }
+  }
+  /** @brief checks whether the index is in the heap */
+  bool contains(size_t index) const {
+    return index < _positions.size() && _positions[index] != NPOS;
+  }
+  /** @brief returns the index with the smallest priority */
+  size_t topIndex() const { return _heap.front().second; }
+  /** @brief returns the smallest priority */
+  const Priority &topPriority() const { return _heap.front().first; }
+  /** @brief removes and returns the index with the smallest priority */
+  size_t pop() {
+    size_t index = topIndex();
+    remove(index);
+    return index;
+  }
+  /** @brief returns true if the heap is empty */
+  bool empty() const { return _heap.empty(); }
+  /** @brief returns the number of entries */
+  size_t size() const { return _heap.size(); }
+  /** @brief removes all entries */
+  void clear() {
+    _heap.clear();
+    _positions.clear();
+  }
+
+private:
+  Compare _compare;
+  std::vector<std::pair<Priority, size_t>> _heap;
+  // position of each index in the heap or NPOS
+  std::vector<size_t> _positions;
+
+  void swapEntries(size_t a, size_t b) {
+    std::swap(_heap[a], _heap[b]);
+    _positions[_heap[a].second] = a;
+    _positions[_heap[b].second] = b;
+  }
+  bool less(size_t a, size_t b) const {
+    // ties are broken by index to make the order deterministic
+    if (_compare(_heap[a].first, _heap[b].first)) {
+      return true;
+    }
+    if (_compare(_heap[b].first, _heap[a].first)) {
+      return false;
+    }
+    return _heap[a].second < _heap[b].second;
+  }
+  size_t siftUp(size_t pos) {
+    while (pos > 0) {
+      size_t parent = (pos - 1) / 2;
+      if (!less(pos, parent)) {
+        break;
+      }
+      swapEntries(pos, parent);
+      pos = parent;
+    }
+    return pos;
+  }
+  size_t siftDown(size_t pos) {
+    while (true) {
+      size_t smallest = pos;
+      size_t left = 2 * pos + 1;
+      size_t right = left + 1;
+      if (left < _heap.size() && less(left, smallest)) {
+        smallest = left;
+      }
+      if (right < _heap.size() && less(right, smallest)) {
+        smallest = right;
+      }
+      if (smallest == pos) {
+        return pos;
+      }
+      swapEntries(pos, smallest);
+      pos = smallest;
+    }
+  }
+};
+
+}  // namespace estnet
+
+#endif
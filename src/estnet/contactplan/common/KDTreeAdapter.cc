@@ -108,7 +108,7 @@ unsigned int KDTreeAdapter::computeCommRadius(const IRadio *iRadio,
 unsigned int KDTreeAdapter::calcGeomConstrRadius(const Radio *radio,
         const Radio *radioPartner) {
     //calculate geometric constrained radius
-    const NodeBase *nodeBase;
+    const NodeBase *nodeBase = nullptr;
     bool isISL = false;
     if (0
             == strcmp(
@@ -131,6 +131,9 @@ unsigned int KDTreeAdapter::calcGeomConstrRadius(const Radio *radio,
                 check_and_cast<const NodeBase*>(
                         radioPartner->getParentModule()->getParentModule()->getParentModule());
     }
+    //no satellite involved, so there is no orbit constraining the radius
+    if (nodeBase == nullptr)
+        return 1000000000;
     //check for linear mobility for testing reasons
     if (nodeBase->getMobility() == nullptr)
         return 1000000000;
@@ -18,6 +18,8 @@
 
 #include "IEarthModel.h"
 
+#include <cmath>
+
 namespace estnet {
 
 void IEarthModel::convertECEFToLatLongHeight(const inet::Coord &ecef,
@@ -169,5 +171,124 @@ inetu::deg IEarthModel::calculateElevation(const inetu::deg &lat1,
                     / (1 - (r_gs * cos(angularDistance) / (r_sat)).get()));
     return inetu::rad( M_PI / 2 - angularDistance - nadirAngle);
 }
-} // namespace estnet
 
+void IEarthModel::convertECEFToLatLongHeightBatch(const double *x,
+        const double *y, const double *z, size_t count, double *latitude,
+        double *longitude, double *altitude) const {
+    inetu::deg lat, lon;
+    inetu::m alt;
+    for (size_t i = 0; i < count; i++) {
+        this->convertECEFToLatLongHeight(inetu::m(x[i]), inetu::m(y[i]),
+                inetu::m(z[i]), lat, lon, alt);
+        latitude[i] = lat.get();
+        longitude[i] = lon.get();
+        altitude[i] = alt.get();
+    }
+}
+
+void IEarthModel::convertLatLongHeightToECEFBatch(const double *latitude,
+        const double *longitude, const double *altitude, size_t count,
+        double *x, double *y, double *z) const {
+    inetu::m ecefX, ecefY, ecefZ;
+    for (size_t i = 0; i < count; i++) {
+        this->convertLatLongHeightToECEF(inetu::deg(latitude[i]),
+                inetu::deg(longitude[i]), inetu::m(altitude[i]), ecefX, ecefY,
+                ecefZ);
+        x[i] = ecefX.get();
+        y[i] = ecefY.get();
+        z[i] = ecefZ.get();
+    }
+}
+
+void IEarthModel::convertECIToECEFBatch(cJulian time, const double *eciX,
+        const double *eciY, const double *eciZ, size_t count, double *ecefX,
+        double *ecefY, double *ecefZ) const {
+    // rotate back by the greenwich sidereal angle around the z axis
+    const double gmst = inetu::rad(time.toGMST()).get();
+    const double c = std::cos(gmst);
+    const double s = std::sin(gmst);
+    for (size_t i = 0; i < count; i++) {
+        const double x = eciX[i];
+        const double y = eciY[i];
+        ecefX[i] = c * x + s * y;
+        ecefY[i] = c * y - s * x;
+        ecefZ[i] = eciZ[i];
+    }
+}
+
+void IEarthModel::convertECEFToECIBatch(cJulian time, const double *ecefX,
+        const double *ecefY, const double *ecefZ, size_t count, double *eciX,
+        double *eciY, double *eciZ) const {
+    const double gmst = inetu::rad(time.toGMST()).get();
+    const double c = std::cos(gmst);
+    const double s = std::sin(gmst);
+    for (size_t i = 0; i < count; i++) {
+        const double x = ecefX[i];
+        const double y = ecefY[i];
+        eciX[i] = c * x - s * y;
+        eciY[i] = c * y + s * x;
+        eciZ[i] = ecefZ[i];
+    }
+}
+
+void IEarthModel::convertECIToLatLongHeightBatch(cJulian time, const double *x,
+        const double *y, const double *z, size_t count, double *latitude,
+        double *longitude, double *altitude) const {
+    this->convertECEFToLatLongHeightBatch(x, y, z, count, latitude, longitude,
+            altitude);
+    // remove longitude advancement (Earth rotation) like the conversion of
+    // a single point
+    const double gmst = time.toGMST().get();
+    for (size_t i = 0; i < count; i++) {
+        const double lon = longitude[i] - gmst;
+        longitude[i] = lon < 0.0 ? lon + 360.0 : lon;
+    }
+}
+
+void IEarthModel::calculateElevationAzimuthBatch(cJulian time, const double *x1,
+        const double *y1, const double *z1, const double *x2, const double *y2,
+        const double *z2, size_t count, double *elevation, double *azimuth,
+        double *scratch) const {
+    double *lat1 = scratch, *lon1 = lat1 + count, *alt1 = lon1 + count;
+    double *lat2 = alt1 + count, *lon2 = lat2 + count, *alt2 = lon2 + count;
+    this->convertECIToLatLongHeightBatch(time, x1, y1, z1, count, lat1, lon1,
+            alt1);
+    this->convertECIToLatLongHeightBatch(time, x2, y2, z2, count, lat2, lon2,
+            alt2);
+
+    const double degToRad = M_PI / 180.0;
+    for (size_t i = 0; i < count; i++) {
+        // same spherical geometry as calculateElevation
+        const double sinLat1 = std::sin(lat1[i] * degToRad);
+        const double cosLat1 = std::cos(lat1[i] * degToRad);
+        const double sinLat2 = std::sin(lat2[i] * degToRad);
+        const double cosLat2 = std::cos(lat2[i] * degToRad);
+        const double deltaLon = (lon2[i] - lon1[i]) * degToRad;
+        const double cosDeltaLon = std::cos(deltaLon);
+        const double angularDistance = std::acos(
+                sinLat1 * sinLat2 + cosLat1 * cosLat2 * cosDeltaLon);
+        const bool firstIsGround = alt1[i] <= alt2[i];
+        const double r_gs = (firstIsGround ? alt1[i] : alt2[i]) + EARTH_AVG_R;
+        const double r_sat = (firstIsGround ? alt2[i] : alt1[i]) + EARTH_AVG_R;
+        const double nadirAngle = std::atan(
+                (r_gs * std::sin(angularDistance) / r_sat)
+                        / (1 - r_gs * std::cos(angularDistance) / r_sat));
+        elevation[i] = (M_PI / 2 - angularDistance - nadirAngle) / degToRad;
+
+        if (azimuth != nullptr) {
+            // initial great circle bearing from the ground point
+            const double sinLatG = firstIsGround ? sinLat1 : sinLat2;
+            const double cosLatG = firstIsGround ? cosLat1 : cosLat2;
+            const double sinLatS = firstIsGround ? sinLat2 : sinLat1;
+            const double cosLatS = firstIsGround ? cosLat2 : cosLat1;
+            const double sinDeltaLon = std::sin(
+                    firstIsGround ? deltaLon : -deltaLon);
+            const double az = std::atan2(sinDeltaLon * cosLatS,
+                    cosLatG * sinLatS - sinLatG * cosLatS * cosDeltaLon)
+                    / degToRad;
+            azimuth[i] = az < 0 ? az + 360.0 : az;
+        }
+    }
+}
+
+} // namespace estnet
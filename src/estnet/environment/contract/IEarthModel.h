@@ -188,6 +188,118 @@ public:
             const inetu::deg &lat2, const inetu::deg &long2,
             const inetu::m &alt2) const;
 
+    /**
+     * @brief Converts ECEF cartesian coordinates of many points to latitude,
+     *  longitude, altitude, like the conversion of a single point
+     * @param x array of count x coordinates in meters
+     * @param y array of count y coordinates in meters
+     * @param z array of count z coordinates in meters
+     * @param count number of points
+     * @param latitude array of count latitudes in degrees, return value
+     * @param longitude array of count longitudes in degrees, return value
+     * @param altitude array of count altitudes in meters, return value
+     *
+     * The output arrays must not overlap the input arrays.
+     */
+    virtual void convertECEFToLatLongHeightBatch(const double *x,
+            const double *y, const double *z, size_t count, double *latitude,
+            double *longitude, double *altitude) const;
+
+    /**
+     * @brief Converts latitude, longitude, altitude of many points to ECEF
+     *  cartesian coordinates, like the conversion of a single point
+     * @param latitude array of count latitudes in degrees
+     * @param longitude array of count longitudes in degrees
+     * @param altitude array of count altitudes in meters
+     * @param count number of points
+     * @param x array of count x coordinates in meters, return value
+     * @param y array of count y coordinates in meters, return value
+     * @param z array of count z coordinates in meters, return value
+     */
+    virtual void convertLatLongHeightToECEFBatch(const double *latitude,
+            const double *longitude, const double *altitude, size_t count,
+            double *x, double *y, double *z) const;
+
+    /**
+     * @brief Converts ECI coordinates of many points to ECEF coordinates
+     *  by removing the earth rotation
+     * @param time: julian date of all points
+     * @param eciX array of count x coordinates in meters
+     * @param eciY array of count y coordinates in meters
+     * @param eciZ array of count z coordinates in meters
+     * @param count number of points
+     * @param ecefX array of count x coordinates in meters, return value,
+     *  may be the same array as eciX
+     * @param ecefY array of count y coordinates in meters, return value,
+     *  may be the same array as eciY
+     * @param ecefZ array of count z coordinates in meters, return value,
+     *  may be the same array as eciZ
+     */
+    virtual void convertECIToECEFBatch(cJulian time, const double *eciX,
+            const double *eciY, const double *eciZ, size_t count,
+            double *ecefX, double *ecefY, double *ecefZ) const;
+
+    /**
+     * @brief Converts ECEF coordinates of many points to ECI coordinates
+     *  by adding the earth rotation
+     * @param time: julian date of all points
+     * @param ecefX array of count x coordinates in meters
+     * @param ecefY array of count y coordinates in meters
+     * @param ecefZ array of count z coordinates in meters
+     * @param count number of points
+     * @param eciX array of count x coordinates in meters, return value,
+     *  may be the same array as ecefX
+     * @param eciY array of count y coordinates in meters, return value,
+     *  may be the same array as ecefY
+     * @param eciZ array of count z coordinates in meters, return value,
+     *  may be the same array as ecefZ
+     */
+    virtual void convertECEFToECIBatch(cJulian time, const double *ecefX,
+            const double *ecefY, const double *ecefZ, size_t count,
+            double *eciX, double *eciY, double *eciZ) const;
+
+    /**
+     * @brief Converts ECI coordinates of many points to latitude, longitude
+     *  and altitude, like the conversion of a single point
+     * @param time: julian date of all points
+     * @param x array of count x coordinates in meters
+     * @param y array of count y coordinates in meters
+     * @param z array of count z coordinates in meters
+     * @param count number of points
+     * @param latitude array of count latitudes in degrees, return value
+     * @param longitude array of count longitudes in degrees, return value
+     * @param altitude array of count altitudes in meters, return value
+     *
+     * The output arrays must not overlap the input arrays.
+     */
+    virtual void convertECIToLatLongHeightBatch(cJulian time, const double *x,
+            const double *y, const double *z, size_t count, double *latitude,
+            double *longitude, double *altitude) const;
+
+    /** @brief calculate elevation and azimuth between many pairs of points
+     *  given in ECI coordinates. For each pair the point with the lower
+     *  altitude is the ground point, like in ~calculateElevation
+     *  @param time: julian date of all points
+     *  @param x1 array of count x coordinates of the first points in meters
+     *  @param y1 array of count y coordinates of the first points in meters
+     *  @param z1 array of count z coordinates of the first points in meters
+     *  @param x2 array of count x coordinates of the second points in meters
+     *  @param y2 array of count y coordinates of the second points in meters
+     *  @param z2 array of count z coordinates of the second points in meters
+     *  @param count number of pairs
+     *  @param elevation array of count elevation angles in degrees, return
+     *      value
+     *  @param azimuth array of count azimuth angles from the ground point
+     *      in degrees clockwise from north in [0, 360), return value,
+     *      may be null
+     *  @param scratch array of 6 * count doubles, which is overwritten, so
+     *      that repeated calls can reuse the memory
+     */
+    virtual void calculateElevationAzimuthBatch(cJulian time, const double *x1,
+            const double *y1, const double *z1, const double *x2,
+            const double *y2, const double *z2, size_t count,
+            double *elevation, double *azimuth, double *scratch) const;
+
 private:
 
     /*
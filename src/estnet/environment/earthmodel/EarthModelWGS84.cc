@@ -0,0 +1,84 @@
+//
+// Copyright (C) 2020 Computer Science VII: Robotics and Telematics - 
+// Julius-Maximilians-Universitaet Wuerzburg
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see http://www.gnu.org/licenses/.
+//
+
+#include "EarthModelWGS84.h"
+
+namespace estnet {
+
+// this file is compiled with -fno-math-errno and -fno-trapping-math (see
+// makefrag), otherwise each sqrt is a branch to set errno and the altitude
+// at the poles is not selected without a branch, so the loops would not be
+// vectorized
+
+void EarthModelWGS84::convertECEFToLatLongHeightBatch(const double *x,
+        const double *y, const double *z, size_t count, double *latitude,
+        double *longitude, double *altitude) const {
+    const double a = _radiusEquator.get();
+    const double b = _radiusPolar.get();
+    const double e2 = _eccentricitySquared;
+    const double ep2b = (a * a - b * b) / b;
+    const double e2a = e2 * a;
+    const double radToDeg = 180.0 / M_PI;
+    // altitude and tangent of the latitude, without calls to atan
+    for (size_t i = 0; i < count; i++) {
+        const double p = std::sqrt(x[i] * x[i] + y[i] * y[i]);
+        // sine and cosine of theta = atan2(z * a, p * b)
+        const double za = z[i] * a;
+        const double pb = p * b;
+        const double invR = 1.0 / std::sqrt(za * za + pb * pb);
+        const double sinTheta = za * invR;
+        const double cosTheta = pb * invR;
+        const double num = z[i] + ep2b * sinTheta * sinTheta * sinTheta;
+        const double den = p - e2a * cosTheta * cosTheta * cosTheta;
+        const double invH = 1.0 / std::sqrt(num * num + den * den);
+        const double sinLat = num * invH;
+        const double cosLat = den * invH;
+        const double N = a / std::sqrt(1.0 - e2 * sinLat * sinLat);
+        // den is positive except at the poles, where it is zero and the
+        // latitude is atan(+-inf), +-90 degrees
+        const double ellipsoidHeight = p / cosLat - N;
+        const double polarHeight = std::abs(z[i]) - b;
+        altitude[i] = cosLat > 0.0 ? ellipsoidHeight : polarHeight;
+        latitude[i] = num / den;
+    }
+    for (size_t i = 0; i < count; i++) {
+        latitude[i] = std::atan(latitude[i]) * radToDeg;
+        longitude[i] = std::atan2(y[i], x[i]) * radToDeg;
+    }
+}
+
+void EarthModelWGS84::convertLatLongHeightToECEFBatch(const double *latitude,
+        const double *longitude, const double *altitude, size_t count,
+        double *x, double *y, double *z) const {
+    const double a = _radiusEquator.get();
+    const double e2 = _eccentricitySquared;
+    const double degToRad = M_PI / 180.0;
+    for (size_t i = 0; i < count; i++) {
+        const double sinLat = std::sin(latitude[i] * degToRad);
+        const double cosLat = std::cos(latitude[i] * degToRad);
+        const double sinLon = std::sin(longitude[i] * degToRad);
+        const double cosLon = std::cos(longitude[i] * degToRad);
+        const double N = a / std::sqrt(1.0 - e2 * sinLat * sinLat);
+        const double r = (N + altitude[i]) * cosLat;
+        x[i] = r * cosLon;
+        y[i] = r * sinLon;
+        z[i] = (N * (1 - e2) + altitude[i]) * sinLat;
+    }
+}
+
+}  // namespace estnet
@@ -19,6 +19,8 @@
 #ifndef __EARTH_MODEL_EARTH_MODEL_WGS84_H__
 #define __EARTH_MODEL_EARTH_MODEL_WGS84_H__
 
+#include <cmath>
+
 #include "estnet/environment/contract/IEarthModel.h"
 
 namespace estnet {
@@ -120,6 +122,28 @@ public:
         z = (N * (1 - _eccentricitySquared) + altitude) * sin_latitude;
     }
 
+    /**
+     * @brief Converts many ECEF cartesian coordinates to latitude, longitude
+     * and altitude with the same closed form (one Bowring step) as the single
+     * point conversion. The sine and cosine of the auxiliary angle and of the
+     * latitude are derived algebraically, so the altitude and the tangent of
+     * the latitude are computed in a branch-free loop of arithmetic and
+     * square roots, which the compiler vectorizes. The atan and atan2 per
+     * point follow in a second, scalar loop.
+     */
+    virtual void convertECEFToLatLongHeightBatch(const double *x,
+            const double *y, const double *z, size_t count, double *latitude,
+            double *longitude, double *altitude) const;
+
+    /**
+     * @brief Converts many latitudes, longitudes and altitudes to ECEF
+     * cartesian coordinates with the same formula as the single point
+     * conversion
+     */
+    virtual void convertLatLongHeightToECEFBatch(const double *latitude,
+            const double *longitude, const double *altitude, size_t count,
+            double *x, double *y, double *z) const;
+
 private:
     const inetu::m _radiusPolar;   // measured in meters
     const inetu::m _radiusEquator; // measured in meters
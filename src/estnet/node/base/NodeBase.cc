@@ -36,30 +36,66 @@ void NodeBase::initialize(int stage) {
         this->uplinkCoverageId = registerSignal("uplinkCoverage");
         this->downlinkCoverageId = registerSignal("downLinkCoverage");
         this->_nodeNo = this->par("nodeNo").intValue();
+        // modules created or deleted inside the node invalidate the
+        // cached lookups, see receiveSignal
+        this->subscribe(omnetpp::PRE_MODEL_CHANGE, this);
+        this->subscribe(omnetpp::POST_MODEL_CHANGE, this);
+        this->invalidateModuleCache();
     }
 }
 
-std::vector<IApp*> NodeBase::getApps() const {
-    std::vector<IApp*> apps;
-    auto networkHost = this->getSubmodule("networkHost");
-    int numApps = networkHost->par("numApps").intValue();
-    for (int i = 0; i < numApps; i++) {
-        IApp *app = omnetpp::check_and_cast<IApp*>(
-                networkHost->getSubmodule("appWrapper", i)->getSubmodule(
-                        "app"));
-        apps.push_back(app);
+void NodeBase::receiveSignal(omnetpp::cComponent *source,
+        omnetpp::simsignal_t signal, omnetpp::cObject *object,
+        omnetpp::cObject *details) {
+    // model change notifications of the modules inside the node are
+    // propagated to the node, other changes like display strings and
+    // gates don't affect the lookups
+    if (dynamic_cast<omnetpp::cPostModuleAddNotification*>(object)
+            || dynamic_cast<omnetpp::cPreModuleDeleteNotification*>(object)
+            || dynamic_cast<omnetpp::cPostModuleDeleteNotification*>(object)) {
+        this->invalidateModuleCache();
     }
-    return apps;
+}
+
+void NodeBase::invalidateModuleCache() {
+    this->_appsValid = false;
+    this->_apps.clear();
+    this->_nodeContactManagerValid = false;
+    this->_nodeContactManager = nullptr;
+}
+
+const std::vector<IApp*>& NodeBase::getApps() const {
+    if (!this->_appsValid) {
+        this->_apps.clear();
+        auto networkHost = this->getSubmodule("networkHost");
+        int numApps = networkHost->par("numApps").intValue();
+        for (int i = 0; i < numApps; i++) {
+            IApp *app = omnetpp::check_and_cast<IApp*>(
+                    networkHost->getSubmodule("appWrapper", i)->getSubmodule(
+                            "app"));
+            this->_apps.push_back(app);
+        }
+        this->_appsValid = true;
+    }
+    return this->_apps;
 }
 
 bool NodeBase::contactManagementEnabled() const {
-    std::string test(this->par("nodeContactManager").stringValue());
-    return !test.empty();
+    if (!this->_nodeContactManagerValid) {
+        NodeBase::getNodeContactManager();
+    }
+    return this->_contactManagementEnabled;
 }
 
 NodeContactManager* NodeBase::getNodeContactManager() const {
-    return dynamic_cast<NodeContactManager*>(this->getSubmodule("networkHost")->getSubmodule(
-            this->par("nodeContactManager").stringValue()));
+    if (!this->_nodeContactManagerValid) {
+        const char *name = this->par("nodeContactManager").stringValue();
+        this->_contactManagementEnabled = name[0] != '\0';
+        this->_nodeContactManager = dynamic_cast<NodeContactManager*>(
+                this->getSubmodule("networkHost")->getSubmodule(name));
+        this->_nodeContactManagerValid = true;
+    }
+    return this->_nodeContactManager;
 }
 
 NodeContactManager* NodeBase::getNodeContactManagerInternal() const {
@@ -117,8 +153,23 @@ void NodeBase::waitForLimboDecisions(bool reset) {
     }
 }
 
+void NodeBase::unsubscribeModelChanges() {
+    if (this->isSubscribed(omnetpp::PRE_MODEL_CHANGE, this)) {
+        this->unsubscribe(omnetpp::PRE_MODEL_CHANGE, this);
+    }
+    if (this->isSubscribed(omnetpp::POST_MODEL_CHANGE, this)) {
+        this->unsubscribe(omnetpp::POST_MODEL_CHANGE, this);
+    }
+}
+
 void NodeBase::finish() {
+    this->unsubscribeModelChanges();
     omnetpp::cModule::finish();
 }
 
+NodeBase::~NodeBase() {
+    // finish is not called if the simulation ends with an error
+    this->unsubscribeModelChanges();
+}
+
 }  // namespace estnet
@@ -30,29 +30,53 @@ namespace estnet {
 
 /**
  * Common base class for all communicating
- *  nodes in the simulation
+ *  nodes in the simulation.
+ *  The apps and the node contact manager are looked up once and cached,
+ *  the cache is dropped whenever modules inside the node are created or deleted.
  */
-class ESTNET_API NodeBase: public omnetpp::cModule {
+class ESTNET_API NodeBase: public omnetpp::cModule, public omnetpp::cListener {
 private:
     omnetpp::simsignal_t uplinkCoverageId;
     omnetpp::simsignal_t downlinkCoverageId;
     NodeContactManager* getNodeContactManagerInternal() const;
 
+    // cached module lookups, valid until the next model change
+    mutable bool _appsValid = false;
+    mutable std::vector<IApp*> _apps;
+    mutable bool _nodeContactManagerValid = false;
+    mutable NodeContactManager *_nodeContactManager = nullptr;
+    mutable bool _contactManagementEnabled = false;
+
+    /** @brief drops the cached module lookups */
+    void invalidateModuleCache();
+
+    /** @brief stops listening to model changes, if still subscribed */
+    void unsubscribeModelChanges();
+
 protected:
     unsigned int _nodeNo;
     virtual int numInitStages() const override;
     virtual void initialize(int stage) override;
     /** @brief cleanup */
     virtual void finish() override;
+    using omnetpp::cListener::finish;
+    /** @brief drops the cached module lookups when modules inside
+     *  the node are created or deleted */
+    virtual void receiveSignal(omnetpp::cComponent *source,
+            omnetpp::simsignal_t signal, omnetpp::cObject *object,
+            omnetpp::cObject *details) override;
 
 public:
+    /** @brief cleanup */
+    virtual ~NodeBase();
+
     /** @brief returns the node no */
     unsigned int getNodeNo() const {
         return this->_nodeNo;
     }
 
-    /** @brief returns the apps */
-    std::vector<IApp*> getApps() const;
+    /** @brief returns the apps, indexed by app id */
+    const std::vector<IApp*>& getApps() const;
 
     /** @brief Checks whether the node has a node manager */
     virtual bool contactManagementEnabled() const;
@@ -20,7 +20,10 @@
 
 #include <inet/physicallayer/base/packetlevel/NarrowbandReceiverBase.h>
 
+#include "estnet/common/ModuleAccess.h"
 #include "estnet/common/node/NodeRegistry.h"
+#include "estnet/environment/earthmodel/EarthModelFactory.h"
+#include "NodeFailureScheduler.h"
 
 namespace estnet {
 
@@ -80,6 +83,11 @@ void JammedPacketHandler::initialize(int stage) {
             }
             this->_jammers.push_back(jammer);
         }
+        this->_jammerVisibility.resize(this->_jammers.size());
+        this->_nextJammerCheck = SIMTIME_ZERO;
+        this->_maxJammerCheckInterval = this->par("maxJammerCheckInterval");
+        this->_earthModel = EarthModelFactory::get(
+                EarthModelFactory::EarthModels::WGS84);
 
         // set counter to zero and emit the initial value
         this->_lostPacketCounter = 0;
@@ -100,20 +108,24 @@ void JammedPacketHandler::initialize(int stage) {
         strStream << _node->getNodeNo() << "/nodefailure";
         _msgKey = strStream.str();
 
-        subscribeTopic (_msgKey);
+        // the central scheduler keeps the failure state of all nodes,
+        // without it the failure model publishes the state
+        this->_failureScheduler = getModuleFromPar<NodeFailureScheduler>(
+                this->par("failureSchedulerModule"), this, false);
+        if (this->_failureScheduler == nullptr) {
+            subscribeTopic(_msgKey);
+        }
     }
 }
 
 void JammedPacketHandler::handleMessage(cMessage *msg) {
     if (msg->arrivedOn("lowerLayerIn") || msg->arrivedOn("upperLayerIn")) {
         //check whether node is jammed by a jammingStation
-        inet::Coord position = this->_node->getMobility()->getCurrentPosition();
+        this->updateJammersInRange();
         bool isJammed = false;
-        for (JammingStation *jammer : this->_jammers) {
-            if (jammer->isInJammingRange(position)) {
-                if (uniform(0, 1) < jammer->getProbability()) {
-                    isJammed = true;
-                }
+        for (JammingStation *jammer : this->_jammersInRange) {
+            if (uniform(0, 1) < jammer->getProbability()) {
+                isJammed = true;
             }
         }
         if (isJammed && !msg->arrivedOn("upperLayerIn")) {
@@ -122,7 +134,7 @@ void JammedPacketHandler::handleMessage(cMessage *msg) {
             this->emit(jammedPacketCount, this->_jammedPacketCounter);
             EV_INFO << "Node got jammed: Packet is lost" << omnetpp::endl;
             delete msg;
-        } else if (_nodeFailureState) {
+        } else if (this->isNodeFailed()) {
             // node is in failure state
             this->_lostPacketCounter++;
             this->emit(lostPacketCount, this->_lostPacketCounter);
@@ -143,9 +155,70 @@ void JammedPacketHandler::handleMessage(cMessage *msg) {
     }
 }
 
+void JammedPacketHandler::updateJammersInRange() {
+    omnetpp::simtime_t now = omnetpp::simTime();
+    if (this->_jammers.empty() || now < this->_nextJammerCheck) {
+        return;
+    }
+
+    // position of the node, converted once for all jammers
+    inet::IMobility *mobility = this->_node->getMobility();
+    inet::Coord position = mobility->getCurrentPosition();
+    inetu::deg latitude, longitude;
+    inetu::m altitude;
+    this->_earthModel->convertECIToLatLongHeight(
+            GlobalJulianDate::getInstance().currentSimTime(), position,
+            latitude, longitude, altitude);
+
+    // upper bound of the angular speed of the sub point, the safety factor
+    // covers altitude changes and the geodetic latitude
+    const double SAFETY_FACTOR = 2;
+    double angularSpeed = SAFETY_FACTOR
+            * (mobility->getCurrentVelocity().length() / position.length()
+                    + EARTH_SPIN * RADS_PER_DEG);
+
+    this->_nextJammerCheck = now + this->_maxJammerCheckInterval;
+    bool changed = false;
+    for (size_t i = 0; i < this->_jammers.size(); i++) {
+        JammerVisibility &visibility = this->_jammerVisibility[i];
+        if (now >= visibility.validUntil) {
+            JammingStation *jammer = this->_jammers[i];
+            bool inRange = jammer->isInJammingRange(latitude, longitude,
+                    altitude);
+            changed |= inRange != visibility.inRange;
+            visibility.inRange = inRange;
+            // the node can't cross the border of the jamming area before
+            // it has covered the angular distance to it
+            double margin = std::abs(
+                    jammer->getJammingAreaMargin(latitude, longitude, altitude).get());
+            visibility.validUntil = now + std::min(
+                    this->_maxJammerCheckInterval,
+                    omnetpp::simtime_t(margin / angularSpeed));
+        }
+        this->_nextJammerCheck = std::min(this->_nextJammerCheck,
+                visibility.validUntil);
+    }
+
+    if (changed) {
+        this->_jammersInRange.clear();
+        for (size_t i = 0; i < this->_jammers.size(); i++) {
+            if (this->_jammerVisibility[i].inRange) {
+                this->_jammersInRange.push_back(this->_jammers[i]);
+            }
+        }
+    }
+}
+
+bool JammedPacketHandler::isNodeFailed() const {
+    if (this->_failureScheduler != nullptr) {
+        return this->_failureScheduler->isFailed(this->_node->getNodeNo());
+    }
+    return this->_nodeFailureState;
+}
+
 void JammedPacketHandler::receivedPubSubMessage(estnet::PubSubMsg *pubSubMsg) {
-    if ((std::string) pubSubMsg->key == _msgKey) {
-        _nodeFailureState = atoi((pubSubMsg->value).c_str());
+    if (pubSubMsg->getKey() == _msgKey) {
+        _nodeFailureState = pubSubMsg->getNumber() != 0;
         EV << "Satellites failure state is " << _nodeFailureState << std::endl;
     }
 }
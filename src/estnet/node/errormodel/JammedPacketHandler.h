@@ -27,6 +27,8 @@
 
 namespace estnet {
 
+class NodeFailureScheduler;
+
 /**
  *  Module that passes packets only in non error state
  */
@@ -60,14 +62,36 @@ protected:
      * These message contain updates to the node failure state
      */
     virtual void receivedPubSubMessage(estnet::PubSubMsg *pubSubMsg);
+    /**
+     * Rechecks the jammers whose visibility window has passed and
+     * updates the list of jammers in range
+     */
+    virtual void updateJammersInRange();
+    /**
+     * Returns the failure state of the node, from the central
+     * scheduler if there is one
+     */
+    bool isNodeFailed() const;
 
 private:
+    /** visibility of a jammer, valid until the node may have left or entered its range */
+    struct JammerVisibility {
+        bool inRange = false;
+        omnetpp::simtime_t validUntil = SIMTIME_ZERO;
+    };
+
     std::vector<JammingStation*> _jammers;  // list of all jammers in network
+    std::vector<JammerVisibility> _jammerVisibility; // visibility of each jammer
+    std::vector<JammingStation*> _jammersInRange; // jammers in range, in the order of _jammers
+    omnetpp::simtime_t _nextJammerCheck;    // end of the first visibility window
+    omnetpp::simtime_t _maxJammerCheckInterval; // upper limit of a visibility window
+    IEarthModel *_earthModel;
     NodeBase *_node;                        // parent node, belonging node for this module
     inet::physicallayer::IRadio *_radio;    // belonging radio for this module
     int _lostPacketCounter;                 // stats of lost packets due to node failure
     int _jammedPacketCounter;               // stats of lost packets due to jammer
-    bool _nodeFailureState;                 // true if there is a node failure
+    bool _nodeFailureState;                 // true if there is a node failure, without central scheduler
+    NodeFailureScheduler *_failureScheduler; // central failure scheduler, if any
     std::string _msgKey;                    // subscription message key
 
     static omnetpp::simsignal_t jammedPacketCount;
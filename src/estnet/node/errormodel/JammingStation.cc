@@ -18,6 +18,8 @@
 
 #include "JammingStation.h"
 
+#include <algorithm>
+
 namespace estnet {
 
 Define_Module(JammingStation);
@@ -60,4 +62,31 @@ bool JammingStation::isInJammingRange(inet::Coord &coordinates) {
     return (elevation > minElevation);
 }
 
+bool JammingStation::isInJammingRange(const inetu::deg &latitude,
+        const inetu::deg &longitude, const inetu::m &altitude) {
+    inetu::deg elevation = this->earthModel->calculateElevation(
+            this->latitude, this->longitude, inetu::m(0), latitude, longitude,
+            altitude);
+
+    return (elevation > minElevation);
+}
+
+inetu::rad JammingStation::getJammingAreaMargin(const inetu::deg &latitude,
+        const inetu::deg &longitude, const inetu::m &altitude) {
+    // angular distance between jammer and sub point, as in the elevation calculation
+    double cosDistance = sin(this->latitude) * sin(latitude)
+            + cos(this->latitude) * cos(latitude)
+                    * cos(inetu::deg(std::abs((this->longitude - longitude).get())));
+    double angularDistance = acos(std::max(-1.0, std::min(1.0, cosDistance)));
+
+    // angular radius of the area with an elevation above the minimum
+    double r_gs = EARTH_AVG_R + std::min(0.0, altitude.get());
+    double r_sat = EARTH_AVG_R + std::max(0.0, altitude.get());
+    double minElevationRad = inetu::rad(this->minElevation).get();
+    double maxDistance = acos(
+            std::max(-1.0, std::min(1.0, r_gs / r_sat * cos(minElevationRad))))
+            - minElevationRad;
+    return inetu::rad(maxDistance - angularDistance);
+}
+
 }  // namespace estnet
@@ -53,6 +53,25 @@ public:
      */
     bool isInJammingRange(inet::Coord &coordinates);
 
+    /**
+     * calculate if an object at the given geographic position is within the
+     * jamming elevation, gives the same result as the ECI variant for the
+     * converted position
+     * @param latitude, longitude, altitude: position of the object
+     * @return bool: returns true, when the object is in elevation range
+     */
+    bool isInJammingRange(const inetu::deg &latitude,
+            const inetu::deg &longitude, const inetu::m &altitude);
+
+    /**
+     * Angular distance of the object's sub point from the border of the
+     * jamming area, as seen from the earth's center
+     * @param latitude, longitude, altitude: position of the object
+     * @return rad: positive inside, negative outside the jamming area
+     */
+    inetu::rad getJammingAreaMargin(const inetu::deg &latitude,
+            const inetu::deg &longitude, const inetu::m &altitude);
+
     /**
      * Returns the propability of jamming the node, when the node is in elevation
      * range
@@ -18,8 +18,10 @@
 
 #include "NodeFailureModel.h"
 
+#include "estnet/common/ModuleAccess.h"
 #include "estnet/common/node/NodeRegistry.h"
 #include "estnet/radio/RadioHost.h"
+#include "NodeFailureScheduler.h"
 
 namespace estnet {
 
@@ -28,12 +30,12 @@ Define_Module(NodeFailureModel);
 omnetpp::simsignal_t NodeFailureModel::nodeFailed = registerSignal(
         "nodeFailed");
 
-void NodeFailureModel::initialize() {
+void NodeFailureModel::initialize(int stage) {
     //getting errormodel status
     bool enable = this->par("enable");
 
     //only start working if enabled
-    if (enable) {
+    if (enable && stage == 0) {
         //initialize all the class members
         this->_node = check_and_cast<Satellite*>(this->getParentModule());
 
@@ -41,9 +43,7 @@ void NodeFailureModel::initialize() {
         this->_MTTF = this->par("MTTF").doubleValue();
         this->_MTTR = this->par("MTTR").doubleValue();
         this->_faultSeed = this->par("faultSeed");
-        _failure = new cMessage("failure");
-        _repaired = new cMessage("repaired");
-        scheduleAt(exponential(_MTTF, _faultSeed), _failure);
+        this->_firstFailure = exponential(_MTTF, _faultSeed);
 
         std::ostringstream strStream;
         strStream << "/omnet/sat/" << _node->getNodeNo() << "/nodefailure";
@@ -51,23 +51,55 @@ void NodeFailureModel::initialize() {
 
         // initialize publisher
         SimplePublisher::initialize();
+    } else if (enable && stage == 1) {
+        // with a central scheduler, the node doesn't schedule its own events
+        this->_scheduler = getModuleFromPar<NodeFailureScheduler>(
+                this->par("failureSchedulerModule"), this, false);
+        if (this->_scheduler != nullptr) {
+            this->_scheduler->registerNode(this, _node->getNodeNo(),
+                    this->_firstFailure);
+        } else {
+            _failure = new cMessage("failure");
+            _repaired = new cMessage("repaired");
+            scheduleAt(this->_firstFailure, _failure);
+        }
     }
+}
 
+NodeFailureModel::~NodeFailureModel() {
+    cancelAndDelete(_failure);
+    cancelAndDelete(_repaired);
+}
+
+bool NodeFailureModel::isFailed() const {
+    if (this->_scheduler != nullptr) {
+        return this->_scheduler->isFailed(this->_node->getNodeNo());
+    }
+    return this->_failed;
+}
+
+void NodeFailureModel::publishTransition(bool failed) {
+    Enter_Method_Silent();
+    this->emit(nodeFailed, failed);
+    publishNumber(failed ? 1.0 : 0.0, _msgKey);
+}
+
+omnetpp::simtime_t NodeFailureModel::drawNextTransition(bool failed) {
+    return simTime() + exponential(failed ? _MTTR : _MTTF, _faultSeed);
 }
 
 void NodeFailureModel::handleMessage(cMessage *msg) {
     //checking what kind of message need to be handled
     if (msg == _failure) {
         //node reboots or processes EDACs
-        this->emit(nodeFailed, true);
-        publishValue(std::to_string(1), _msgKey);
-        scheduleAt(simTime() + exponential(_MTTR, _faultSeed), _repaired);
+        this->_failed = true;
+        this->publishTransition(true);
+        scheduleAt(this->drawNextTransition(true), _repaired);
     } else if (msg == _repaired) {
         //node is repaired and ready to send or receive messages
-        this->emit(nodeFailed, false);
-        publishValue(std::to_string(0), _msgKey);
-
-        scheduleAt(simTime() + exponential(_MTTF, _faultSeed), _failure);
+        this->_failed = false;
+        this->publishTransition(false);
+        scheduleAt(this->drawNextTransition(false), _failure);
     }
 }
 
@@ -30,25 +30,47 @@ using namespace physicallayer;
 
 namespace estnet {
 
+class NodeFailureScheduler;
+
 /*
  * implements failure simulation
  * handles failure due to jamming stations set or radiation
  */
 class ESTNET_API NodeFailureModel: public estnet::SimplePublisher {
+public:
+    /** @brief cleanup */
+    virtual ~NodeFailureModel();
+    /** @brief publishes a failure or repair of the node */
+    virtual void publishTransition(bool failed);
+    /** @brief draws the time of the transition following a failure
+     *  or repair at the current time */
+    virtual omnetpp::simtime_t drawNextTransition(bool failed);
+    /** @brief returns whether the node is failed at the moment,
+     *  kept by the central scheduler if there is one */
+    bool isFailed() const;
+
 protected:
+    /** @brief number of initialization stages, the central scheduler
+     *  is initialized before the nodes register */
+    virtual int numInitStages() const override {
+        return 2;
+    }
     /** @brief initialization of module, checks if errormodel is enabled an sends start messages */
-    virtual void initialize();
+    virtual void initialize(int stage) override;
     /** @brief handles the messages of the errorModel module:
      * the failure/reparation of the node */
     virtual void handleMessage(cMessage *msg);
 
 private:
-    cMessage *_failure;
-    cMessage *_repaired;
+    cMessage *_failure = nullptr;
+    cMessage *_repaired = nullptr;
+    bool _failed = false;                     // only used without central scheduler
+    NodeFailureScheduler *_scheduler = nullptr; // central scheduler, if any
     cMessage *_check_timer;
     double _MTTF, _MTTR;
     int _checkIntervall;
     int _faultSeed;
+    omnetpp::simtime_t _firstFailure; // drawn in the first stage, scheduled in the second
     Satellite *_node;
     std::string _msgKey;
     static omnetpp::simsignal_t nodeFailed;
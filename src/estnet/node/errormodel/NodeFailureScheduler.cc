@@ -0,0 +1,190 @@
+//
+// Copyright (C) 2020 Computer Science VII: Robotics and Telematics - 
+// Julius-Maximilians-Universitaet Wuerzburg
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see http://www.gnu.org/licenses/.
+//
+
+
+#include "NodeFailureScheduler.h"
+
+#include <algorithm>
+#include <sstream>
+
+#include "NodeFailureModel.h"
+
+namespace estnet {
+
+Define_Module(NodeFailureScheduler);
+
+NodeFailureScheduler::~NodeFailureScheduler() {
+    cancelAndDelete(this->_timer);
+}
+
+void NodeFailureScheduler::initialize() {
+    this->_timer = new omnetpp::cMessage("nodeFailureTransition");
+
+    const char *loadTrace = par("loadTrace");
+    if (loadTrace[0] != '\0') {
+        this->loadTrace(loadTrace);
+    }
+    const char *saveTrace = par("saveTrace");
+    if (saveTrace[0] != '\0') {
+        this->_traceOut.open(saveTrace);
+        if (!this->_traceOut.is_open()) {
+            throw omnetpp::cRuntimeError("Cannot open failure trace '%s'",
+                    saveTrace);
+        }
+    }
+    WATCH(this->_numTransitions);
+}
+
+void NodeFailureScheduler::loadTrace(const char *fileName) {
+    std::ifstream in(fileName);
+    if (!in.is_open()) {
+        throw omnetpp::cRuntimeError("Failure trace '%s' not found", fileName);
+    }
+    this->_replay = true;
+    std::string line;
+    int lineNo = 0;
+    while (std::getline(in, line)) {
+        lineNo++;
+        if (line.empty() || line[0] == '#') {
+            continue;
+        }
+        std::istringstream lineStream(line);
+        std::string timeStr;
+        long nodeNo;
+        char sep;
+        int failed;
+        if (!std::getline(lineStream, timeStr, ',')
+                || !(lineStream >> nodeNo >> sep >> failed) || sep != ','
+                || nodeNo < 0 || (failed != 0 && failed != 1)) {
+            throw omnetpp::cRuntimeError(
+                    "Failure trace '%s' line %d: expected 'time,nodeNo,failed'",
+                    fileName, lineNo);
+        }
+        Transition transition;
+        try {
+            transition.time = omnetpp::SimTime::parse(timeStr.c_str());
+        } catch (std::exception &e) {
+            throw omnetpp::cRuntimeError(
+                    "Failure trace '%s' line %d: invalid time '%s'", fileName,
+                    lineNo, timeStr.c_str());
+        }
+        transition.failed = failed;
+        this->reserveNode(nodeNo);
+        this->_trace[nodeNo].push_back(transition);
+    }
+
+    for (size_t nodeNo = 0; nodeNo < this->_trace.size(); nodeNo++) {
+        auto &transitions = this->_trace[nodeNo];
+        std::stable_sort(transitions.begin(), transitions.end(),
+                [](const Transition &a, const Transition &b) {
+                    return a.time < b.time;
+                });
+        if (!transitions.empty()) {
+            this->_nextTransitions.set(nodeNo, transitions.front().time);
+        }
+    }
+    this->rescheduleTimer();
+}
+
+void NodeFailureScheduler::reserveNode(unsigned int nodeNo) {
+    if (nodeNo >= this->_failed.size()) {
+        this->_failed.resize(nodeNo + 1, false);
+        this->_models.resize(nodeNo + 1, nullptr);
+        this->_trace.resize(nodeNo + 1);
+    }
+}
+
+void NodeFailureScheduler::registerNode(NodeFailureModel *model,
+        unsigned int nodeNo, omnetpp::simtime_t firstFailure) {
+    Enter_Method_Silent();
+    this->reserveNode(nodeNo);
+    if (this->_models[nodeNo] != nullptr) {
+        throw omnetpp::cRuntimeError(
+                "Node %u has more than one failure model", nodeNo);
+    }
+    this->_models[nodeNo] = model;
+    if (!this->_replay) {
+        this->_nextTransitions.set(nodeNo, firstFailure);
+        this->rescheduleTimer();
+    }
+}
+
+void NodeFailureScheduler::rescheduleTimer() {
+    if (this->_nextTransitions.empty()) {
+        if (this->_timer->isScheduled()) {
+            cancelEvent(this->_timer);
+        }
+        return;
+    }
+    omnetpp::simtime_t next = this->_nextTransitions.topPriority();
+    if (this->_timer->isScheduled()) {
+        if (this->_timer->getArrivalTime() == next) {
+            return;
+        }
+        cancelEvent(this->_timer);
+    }
+    scheduleAt(next, this->_timer);
+}
+
+void NodeFailureScheduler::handleMessage(omnetpp::cMessage *msg) {
+    if (msg != this->_timer) {
+        throw omnetpp::cRuntimeError("Unexpected message");
+    }
+    omnetpp::simtime_t now = omnetpp::simTime();
+    while (!this->_nextTransitions.empty()
+            && this->_nextTransitions.topPriority() <= now) {
+        unsigned int nodeNo = this->_nextTransitions.pop();
+        bool failed = !this->_failed[nodeNo];
+        if (this->_replay) {
+            failed = this->_trace[nodeNo].front().failed;
+            this->_trace[nodeNo].pop_front();
+        }
+        this->_failed[nodeNo] = failed;
+        this->_numTransitions++;
+        if (this->_traceOut.is_open()) {
+            this->_traceOut << now << "," << nodeNo << "," << failed << "\n";
+        }
+
+        NodeFailureModel *model = this->_models[nodeNo];
+        if (model != nullptr) {
+            model->publishTransition(failed);
+        }
+        // the time is drawn in replays too, so that other modules using
+        // the same random number generator see the same numbers
+        omnetpp::simtime_t next = model != nullptr ?
+                model->drawNextTransition(failed) : SIMTIME_ZERO;
+        if (this->_replay) {
+            if (!this->_trace[nodeNo].empty()) {
+                this->_nextTransitions.set(nodeNo,
+                        this->_trace[nodeNo].front().time);
+            }
+        } else if (model != nullptr) {
+            this->_nextTransitions.set(nodeNo, next);
+        }
+    }
+    this->rescheduleTimer();
+}
+
+void NodeFailureScheduler::finish() {
+    recordScalar("numTransitions", this->_numTransitions);
+    if (this->_traceOut.is_open()) {
+        this->_traceOut.close();
+    }
+}
+
+}  // namespace estnet
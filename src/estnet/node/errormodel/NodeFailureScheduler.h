@@ -0,0 +1,102 @@
+//
+// Copyright (C) 2020 Computer Science VII: Robotics and Telematics - 
+// Julius-Maximilians-Universitaet Wuerzburg
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see http://www.gnu.org/licenses/.
+//
+
+
+#ifndef NODES_ERRORMODEL_NODEFAILURESCHEDULER_H_
+#define NODES_ERRORMODEL_NODEFAILURESCHEDULER_H_
+
+#include <deque>
+#include <fstream>
+#include <vector>
+
+#include <omnetpp.h>
+
+#include "estnet/common/ESTNETDefs.h"
+#include "estnet/common/queue/IndexedHeap.h"
+
+namespace estnet {
+
+class NodeFailureModel;
+
+/**
+ * Central scheduler for the failures of all nodes.
+ * Keeps the next failure or repair of every node in a single indexed
+ * heap and uses one self message for the earliest of them, so the
+ * number of events per failure does not depend on the number of nodes.
+ * The transitions can be written to a trace file and a trace can be
+ * replayed instead of drawing random failures.
+ * Trace files contain one transition per line: "time,nodeNo,failed"
+ * The failure models find the scheduler by module path and register
+ * in their second initialization stage.
+ */
+class ESTNET_API NodeFailureScheduler: public omnetpp::cSimpleModule {
+public:
+    /** @brief cleanup */
+    virtual ~NodeFailureScheduler();
+
+    /**
+     * Registers the failure model of a node.
+     * @param model: model that publishes the transitions and draws the
+     *               time of the next one
+     * @param nodeNo: node number of the node
+     * @param firstFailure: time of the first failure, ignored when a
+     *                      trace is replayed
+     */
+    void registerNode(NodeFailureModel *model, unsigned int nodeNo,
+            omnetpp::simtime_t firstFailure);
+
+    /** @brief checks whether the node is failed at the moment,
+     *  this is the failure state of all nodes with a registered model */
+    bool isFailed(unsigned int nodeNo) const {
+        return nodeNo < this->_failed.size() && this->_failed[nodeNo];
+    }
+
+protected:
+    /** @brief loads the trace and opens the output trace */
+    virtual void initialize() override;
+    /** @brief handles all transitions that are due */
+    virtual void handleMessage(omnetpp::cMessage *msg) override;
+    /** @brief closes the output trace */
+    virtual void finish() override;
+
+private:
+    struct Transition {
+        omnetpp::simtime_t time;
+        bool failed;
+    };
+
+    omnetpp::cMessage *_timer = nullptr;
+    IndexedHeap<omnetpp::simtime_t> _nextTransitions; // next transition of each node
+    std::vector<bool> _failed;                  // failure state indexed by node number
+    std::vector<NodeFailureModel*> _models;     // failure model indexed by node number
+    std::vector<std::deque<Transition>> _trace; // transitions to replay per node
+    bool _replay = false;
+    std::ofstream _traceOut;
+    unsigned long _numTransitions = 0;
+
+    /** @brief reads the trace to replay, if any */
+    void loadTrace(const char *fileName);
+    /** @brief makes sure the tables can hold the node number */
+    void reserveNode(unsigned int nodeNo);
+    /** @brief schedules the timer for the earliest transition */
+    void rescheduleTimer();
+};
+
+}  // namespace estnet
+
+#endif /* NODES_ERRORMODEL_NODEFAILURESCHEDULER_H_ */
@@ -18,6 +18,8 @@
 
 #include "DirectionalScalarBackgroundNoise.h"
 
+#include <cmath>
+
 #include <inet/physicallayer/common/packetlevel/BandListening.h>
 #include <inet/physicallayer/analogmodel/packetlevel/ScalarNoise.h>
 #include <inet/physicallayer/contract/packetlevel/IRadioMedium.h>
@@ -47,6 +49,10 @@ void DirectionalScalarBackgroundNoise::initialize(int stage) {
         this->receiverNoiseTemp = this->par("receiverNoiseTemp").doubleValue();
         this->t_Earth = this->par("t_Earth").doubleValue();
         this->t_Space = this->par("t_Space").doubleValue();
+        this->attitudeQuantum = inet::math::deg2rad(
+                this->par("earthInFOVAttitudeQuantum").doubleValueInUnit(
+                        "deg"));
+        this->altitudeQuantum = this->par("earthInFOVAltitudeQuantum").doubleValueInUnit("m");
     }
 }
 
@@ -59,6 +65,27 @@ const double DirectionalScalarBackgroundNoise::computeEarthInFOV(
             (point_sat * (-satPosition))
                     / (point_sat.length() * satPosition.length())); //angle by that point_sat is off from earth pointing mode
     double h_sat = satPosition.length(); // satellite distance to earth center
+    if (this->attitudeQuantum <= 0 || this->altitudeQuantum <= 0) {
+        return this->computeEarthInFOV(phi_sat, h_sat, beamWidth);
+    }
+
+    // evaluate at the center of the quantization cell, which is shared by
+    // all antennas with the same beamwidth
+    int64_t phiCell = std::floor(phi_sat / this->attitudeQuantum);
+    int64_t hCell = std::floor(h_sat / this->altitudeQuantum);
+    auto key = std::make_tuple(beamWidth, phiCell, hCell);
+    auto it = this->earthInFOVCache.find(key);
+    if (it == this->earthInFOVCache.end()) {
+        double ratio = this->computeEarthInFOV(
+                (phiCell + 0.5) * this->attitudeQuantum,
+                (hCell + 0.5) * this->altitudeQuantum, beamWidth);
+        it = this->earthInFOVCache.emplace(key, ratio).first;
+    }
+    return it->second;
+}
+
+const double DirectionalScalarBackgroundNoise::computeEarthInFOV(
+        double phi_sat, double h_sat, double beamWidth) const {
     double R_E = WGS_84_RADIUS_EQUATOR; // earth radius
     double phi_bw = inet::math::deg2rad(beamWidth / 2); // half the beamwidth in RAD
 
@@ -138,42 +165,34 @@ const double DirectionalScalarBackgroundNoise::computeEarthInFOV(
     return ratio;
 }
 
-const double DirectionalScalarBackgroundNoise::computeAntennaNoise(
-        const inet::physicallayer::IListening *listening) const {
-
-    inet::Quaternion rxOrientation;
-    inet::Coord rxPosition;
-
-    const inet::physicallayer::IAntenna *receiverAntenna =
-            listening->getReceiver()->getAntenna();
-    if (dynamic_cast<SatMobility*>(dynamic_cast<const omnetpp::cModule*>(receiverAntenna)->getParentModule() // radio
+DirectionalScalarBackgroundNoise::AntennaInfo& DirectionalScalarBackgroundNoise::getAntennaInfo(
+        const inet::physicallayer::IAntenna *receiverAntenna) const {
+    const omnetpp::cModule *antennaModule =
+            dynamic_cast<const omnetpp::cModule*>(receiverAntenna);
+    auto it = this->antennaInfos.find(antennaModule->getId());
+    if (it != this->antennaInfos.end()) {
+        return it->second;
+    }
+    AntennaInfo antennaInfo;
+    omnetpp::cModule *mobility = antennaModule->getParentModule() // radio
     ->getParentModule() // wlan
     ->getParentModule() // networkHost
-    ->getSubmodule("mobility")) != nullptr) {
+    ->getSubmodule("mobility");
+    if (dynamic_cast<SatMobility*>(mobility) != nullptr) {
         //Satellite
-        SatMobility *RxMobility =
-                dynamic_cast<SatMobility*>(dynamic_cast<const omnetpp::cModule*>(receiverAntenna)->getParentModule()// radio
-                ->getParentModule() // wlan
-                ->getParentModule() // networkHost
-                ->getSubmodule("mobility"));
-
-        rxOrientation = RxMobility->getCurrentAngularPosition();
-        rxPosition = RxMobility->getCurrentPosition();
-
-    } else if (dynamic_cast<StaticTerrestrialMobility*>(dynamic_cast<const omnetpp::cModule*>(receiverAntenna)->getParentModule()// radio
-    ->getParentModule() // wlan
-    ->getParentModule() // networkHost
-    ->getSubmodule("mobility")) != nullptr) {
+        antennaInfo.mobility = dynamic_cast<SatMobility*>(mobility);
+    } else if (dynamic_cast<StaticTerrestrialMobility*>(mobility) != nullptr) {
         //Ground Station
-        StaticTerrestrialMobility *RxMobility =
-                dynamic_cast<StaticTerrestrialMobility*>(dynamic_cast<const omnetpp::cModule*>(receiverAntenna)->getParentModule()// radio
-                ->getParentModule() // wlan
-                ->getParentModule() // networkHost
-                ->getSubmodule("mobility"));
-        rxOrientation = RxMobility->getCurrentAngularPosition();
-        rxPosition = RxMobility->getCurrentPosition();
+        antennaInfo.mobility = dynamic_cast<StaticTerrestrialMobility*>(mobility);
     }
+    antennaInfo.beamWidth = this->computeBeamWidth(receiverAntenna);
+    antennaInfo.bandwidth = antennaModule->getParentModule() // radio
+    ->par("bandwidth");
+    return this->antennaInfos.emplace(antennaModule->getId(), antennaInfo).first->second;
+}
 
+double DirectionalScalarBackgroundNoise::computeBeamWidth(
+        const inet::physicallayer::IAntenna *receiverAntenna) const {
     //figure out the Antenna type and set the beamwidth accordingly
     double beamWidth = 30.0;
     if (dynamic_cast<const inet::physicallayer::ConstantGainAntenna*>(receiverAntenna)
@@ -220,14 +239,32 @@ const double DirectionalScalarBackgroundNoise::computeAntennaNoise(
         omnetpp::cRuntimeError("Antenna class is not supported "
                 " by directionalScalarBackgroundNoise");
     }
+    return beamWidth;
+}
 
-    //calculate antenna noise
-    double bandwidth =
-            dynamic_cast<const omnetpp::cModule*>(receiverAntenna)->getParentModule() // radio
-            ->par("bandwidth");
+const double DirectionalScalarBackgroundNoise::computeAntennaNoise(
+        const inet::physicallayer::IListening *listening) const {
 
-    double EarthInFOV = this->computeEarthInFOV(rxPosition, rxOrientation,
-            beamWidth);
+    const inet::physicallayer::IAntenna *receiverAntenna =
+            listening->getReceiver()->getAntenna();
+    AntennaInfo &antennaInfo = this->getAntennaInfo(receiverAntenna);
+
+    // positions don't change within a time step
+    if (antennaInfo.earthInFOVTime != omnetpp::simTime()) {
+        inet::Quaternion rxOrientation;
+        inet::Coord rxPosition;
+        if (antennaInfo.mobility != nullptr) {
+            rxOrientation = antennaInfo.mobility->getCurrentAngularPosition();
+            rxPosition = antennaInfo.mobility->getCurrentPosition();
+        }
+        antennaInfo.earthInFOV = this->computeEarthInFOV(rxPosition,
+                rxOrientation, antennaInfo.beamWidth);
+        antennaInfo.earthInFOVTime = omnetpp::simTime();
+    }
+
+    //calculate antenna noise
+    double bandwidth = antennaInfo.bandwidth;
+    double EarthInFOV = antennaInfo.earthInFOV;
     double P_N_earth = t_Earth * K_B * bandwidth;
     double P_N_space = t_Space * K_B * bandwidth;
     double P_N_system = (P_N_earth * EarthInFOV)
@@ -19,8 +19,13 @@
 #ifndef __DIRECTIONAL_SCALAR_BACKGROUND_NOISE_H__
 #define __DIRECTIONAL_SCALAR_BACKGROUND_NOISE_H__
 
+#include <map>
+#include <tuple>
+
 #include <omnetpp.h>
 
+#include <inet/mobility/contract/IMobility.h>
+#include <inet/physicallayer/contract/packetlevel/IAntenna.h>
 #include <inet/physicallayer/contract/packetlevel/IBackgroundNoise.h>
 #include <inet/physicallayer/backgroundnoise/IsotropicScalarBackgroundNoise.h>
 
@@ -31,6 +36,9 @@ namespace estnet {
  * BackgroundNoise class that accounts for the direction the satellite is pointing
  * and how much of its viewing cone is looking at the earth or space. Based on the
  * ratio between earth and space and the temperature of each of them compute the noise power.
+ * The mobility, beamwidth and bandwidth of each antenna are resolved once, the fraction of
+ * the earth in view is computed once per antenna and time step. Optionally it is evaluated
+ * on a grid of attitude and altitude cells shared by all antennas.
  */
 class ESTNET_API DirectionalScalarBackgroundNoise: public inet::physicallayer::IsotropicScalarBackgroundNoise {
 public:
@@ -40,6 +48,12 @@ public:
      */
     virtual const double computeEarthInFOV(inet::Coord SatPosition,
             inet::Quaternion SatOrientation, double beamWidth) const;
+    /*
+     * Computes the percentage of the earth inside the beamwidth of the antenna from the angle
+     * between the antenna pointing and nadir and the distance to the earth center
+     */
+    virtual const double computeEarthInFOV(double phi_sat, double h_sat,
+            double beamWidth) const;
     /*
      * Computes the noise of the antenna by determining the beamwidth of the antenna in use
      * and the fraction of space and earth inside the FOV of the antenna.
@@ -50,11 +64,39 @@ public:
             const inet::physicallayer::IListening *listening) const override;
 
 protected:
+    /*
+     * Properties of a receiving antenna and its last fraction of the earth in view
+     */
+    struct AntennaInfo {
+        inet::IMobility *mobility = nullptr;
+        double beamWidth = 0;
+        double bandwidth = 0;
+        omnetpp::simtime_t earthInFOVTime = -1;
+        double earthInFOV = 0;
+    };
+
     virtual void initialize(int stage) override;
+    /*
+     * Returns the properties of the antenna, resolves them on first use
+     */
+    AntennaInfo& getAntennaInfo(
+            const inet::physicallayer::IAntenna *receiverAntenna) const;
+    /*
+     * Determines the beamwidth of the antenna from its type
+     */
+    virtual double computeBeamWidth(
+            const inet::physicallayer::IAntenna *receiverAntenna) const;
 
     double receiverNoiseTemp;
     double t_Earth;
     double t_Space;
+    double attitudeQuantum;
+    double altitudeQuantum;
+
+    // by antenna module id
+    mutable std::map<int, AntennaInfo> antennaInfos;
+    // by beamwidth, attitude cell and altitude cell
+    mutable std::map<std::tuple<double, int64_t, int64_t>, double> earthInFOVCache;
 
 };
 
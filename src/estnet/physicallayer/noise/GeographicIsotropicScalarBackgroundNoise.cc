@@ -50,6 +50,23 @@ GeographicIsotropicScalarBackgroundNoise::GeographicIsotropicScalarBackgroundNoi
         interpolation() {
 }
 
+GeographicIsotropicScalarBackgroundNoise::ReceiverInfo&
+GeographicIsotropicScalarBackgroundNoise::getReceiverInfo(
+        const inet::physicallayer::IAntenna *receiverAntenna) const {
+    const omnetpp::cModule *antennaModule =
+            dynamic_cast<const omnetpp::cModule*>(receiverAntenna);
+    auto it = receiverInfos.find(antennaModule->getId());
+    if (it == receiverInfos.end()) {
+        ReceiverInfo receiverInfo;
+        receiverInfo.mobility = dynamic_cast<SatMobility*>(antennaModule->getParentModule() // radio
+        ->getParentModule() // wlan
+        ->getParentModule() // networkHost
+        ->getSubmodule("mobility"));
+        it = receiverInfos.emplace(antennaModule->getId(), receiverInfo).first;
+    }
+    return it->second;
+}
+
 const inet::physicallayer::INoise*
 GeographicIsotropicScalarBackgroundNoise::computeNoise(
         const inet::physicallayer::IListening *listening) const {
@@ -65,18 +82,11 @@ GeographicIsotropicScalarBackgroundNoise::computeNoise(
     // inet::Quaternion rxOrientation;
     inet::Coord rxPosition;
 
-    const inet::physicallayer::IAntenna *receiverAntenna =
-            listening->getReceiver()->getAntenna();
-    if (dynamic_cast<SatMobility*>(dynamic_cast<const omnetpp::cModule*>(receiverAntenna)->getParentModule() // radio
-    ->getParentModule() // wlan
-    ->getParentModule() // networkHost
-    ->getSubmodule("mobility")) != nullptr) {
+    ReceiverInfo &receiverInfo = getReceiverInfo(
+            listening->getReceiver()->getAntenna());
+    if (receiverInfo.mobility != nullptr) {
         // Satellite
-        SatMobility *RxMobility =
-                dynamic_cast<SatMobility*>(dynamic_cast<const omnetpp::cModule*>(receiverAntenna)->getParentModule() // radio
-                ->getParentModule() // wlan
-                ->getParentModule() // networkHost
-                ->getSubmodule("mobility"));
+        SatMobility *RxMobility = receiverInfo.mobility;
 
         // rxOrientation = RxMobility->getCurrentAngularPosition();
         rxPosition = RxMobility->getCurrentPosition();
@@ -88,7 +98,8 @@ GeographicIsotropicScalarBackgroundNoise::computeNoise(
                 latitude, longitude, altitude);
 
         localNoisePower = inet::W(
-                interpolation.get(latitude.get(), longitude.get()));
+                interpolation.get(latitude.get(), longitude.get(),
+                        receiverInfo.cell));
         EV_TRACE << "SAT_NOISE (" << latitude << ", " << longitude << ", "
                         << altitude << ") = " << localNoisePower
                         << omnetpp::endl;
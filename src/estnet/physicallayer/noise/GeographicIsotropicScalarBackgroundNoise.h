@@ -18,6 +18,8 @@
 #ifndef __GEOGRAPHIC_ISOTROPIC_SCALAR_BACKGROUND_NOISE_H
 #define __GEOGRAPHIC_ISOTROPIC_SCALAR_BACKGROUND_NOISE_H
 
+#include <map>
+
 #include <omnetpp.h>
 
 #include "inet/physicallayer/backgroundnoise/IsotropicScalarBackgroundNoise.h"
@@ -26,16 +28,26 @@
 #include "estnet/common/ESTNETDefs.h"
 #include "estnet/common/interpolation/SphericalBilinearInterpolation.h"
 #include "estnet/environment/contract/IEarthModel.h"
+#include "estnet/mobility/satellite/SatMobility.h"
 
 namespace estnet {
 
 class ESTNET_API GeographicIsotropicScalarBackgroundNoise
     : public inet::physicallayer::IsotropicScalarBackgroundNoise {
 protected:
+  /** the satellite mobility of a receiver and its last noise map cell */
+  struct ReceiverInfo {
+    SatMobility *mobility = nullptr;
+    SphericalBilinearInterpolation::Cell cell;
+  };
+
   SphericalBilinearInterpolation interpolation;
 
 protected:
   virtual void initialize(int stage) override;
+  /** returns the info of the receiving antenna, resolves it on first use */
+  ReceiverInfo &getReceiverInfo(
+      const inet::physicallayer::IAntenna *receiverAntenna) const;
 
 public:
   GeographicIsotropicScalarBackgroundNoise();
@@ -45,6 +57,8 @@ public:
 
 private:
   IEarthModel *earthModel;
+  // by antenna module id
+  mutable std::map<int, ReceiverInfo> receiverInfos;
 };
 
 } // namespace estnet
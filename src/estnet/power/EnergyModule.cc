@@ -18,8 +18,10 @@
 
 #include "EnergyModule.h"
 
-#include <inet/common/geometry/object/LineSegment.h>
-#include <inet/common/geometry/base/ShapeBase.h>
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
 #include <inet/common/geometry/shape/Sphere.h>
 #include <inet/environment/common/PhysicalEnvironment.h>
 
@@ -29,6 +31,9 @@ using namespace estnet;
 
 Define_Module(EnergyModule);
 
+// mean radius of the sun in m
+static const double SUN_RADIUS = 6.957e8;
+
 void EnergyModule::initialize(int stage) {
     if (stage == 0) {
         //initialize parameter
@@ -42,10 +47,23 @@ void EnergyModule::initialize(int stage) {
                             << "should be between -23.5 to 23.5 deg";
         }
         sunOrientation = sunOrientation * M_PI / 180;
-        double R_SUN = 150000000000.0; //distance sun <-> earth, in m
-        this->_sunPosition.x = R_SUN * cos(sunOrientation);
+        double sunDistance = 150000000000.0; //distance sun <-> earth, in m
+        this->_sunPosition.x = sunDistance * cos(sunOrientation);
         this->_sunPosition.y = 0.0;
-        this->_sunPosition.z = R_SUN * sin(sunOrientation);
+        this->_sunPosition.z = sunDistance * sin(sunOrientation);
+
+        const char *shadowModel = this->par("shadowModel");
+        if (!strcmp(shadowModel, "cylindrical")) {
+            this->_shadowModel = SHADOW_CYLINDRICAL;
+        } else if (!strcmp(shadowModel, "conical")) {
+            this->_shadowModel = SHADOW_CONICAL;
+        } else {
+            throw omnetpp::cRuntimeError("Unknown shadow model '%s'",
+                    shadowModel);
+        }
+
+        this->_transitionSearchStep = this->par("transitionSearchStep");
+        this->_transitionSearchHorizon = this->par("transitionSearchHorizon");
 
         //grab mobility of this node
         this->_mobility = omnetpp::check_and_cast<Satellite*>(
@@ -57,29 +75,160 @@ inet::Coord EnergyModule::getSunPosition() {
     return this->_sunPosition;
 }
 
+double EnergyModule::computeIllumination(const inet::Coord &satPosition,
+        const inet::Coord &sunPosition, double earthRadius,
+        ShadowModel model) {
+    inet::Coord satSun = sunPosition - satPosition;
+    if (model == SHADOW_CYLINDRICAL) {
+        // check whether the satellite sun line passes through the earth sphere
+        double t = -(satPosition * satSun) / (satSun * satSun);
+        t = std::max(0.0, std::min(1.0, t));
+        inet::Coord closest = satPosition + satSun * t;
+        return closest.squareLength() <= earthRadius * earthRadius ? 0 : 1;
+    }
+
+    // apparent radii of sun and earth and their apparent separation
+    // as seen from the satellite (Montenbruck, Gill: Satellite Orbits, 3.4.2)
+    double satDistance = satPosition.length();
+    double sunDistance = satSun.length();
+    if (satDistance <= earthRadius) {
+        return 0;
+    }
+    double a = asin(std::min(1.0, SUN_RADIUS / sunDistance));
+    double b = asin(earthRadius / satDistance);
+    inet::Coord satEarth = satPosition * -1;
+    double c = atan2((satEarth % satSun).length(), satEarth * satSun);
+    if (c >= a + b) {
+        return 1;
+    }
+    if (c <= b - a) {
+        return 0;
+    }
+    if (c <= a - b) {
+        // annular eclipse, earth disk completely in front of the sun disk
+        return 1 - (b * b) / (a * a);
+    }
+    // partial overlap of the two disks
+    double x = (c * c + a * a - b * b) / (2 * c);
+    double y = sqrt(std::max(0.0, a * a - x * x));
+    double area = a * a * acos(std::max(-1.0, std::min(1.0, x / a)))
+            + b * b * acos(std::max(-1.0, std::min(1.0, (c - x) / b))) - c * y;
+    return std::max(0.0, std::min(1.0, 1 - area / (M_PI * a * a)));
+}
+
+double EnergyModule::computeShadowFunction(const inet::Coord &satPosition,
+        const inet::Coord &sunPosition, double earthRadius,
+        double boundaryFactor) {
+    inet::Coord satSun = sunPosition - satPosition;
+    inet::Coord satEarth = satPosition * -1;
+    double a = asin(std::min(1.0, SUN_RADIUS / satSun.length()));
+    double b = asin(std::min(1.0, earthRadius / satEarth.length()));
+    double c = atan2((satEarth % satSun).length(), satEarth * satSun);
+    return c - b - boundaryFactor * a;
+}
+
+double EnergyModule::shadowFunctionAt(double time, double boundaryFactor) {
+    return computeShadowFunction(this->_mobility->getPositionAtTime(time),
+            this->_sunPosition, this->getEarthRadius(), boundaryFactor);
+}
+
+omnetpp::simtime_t EnergyModule::getNextShadowTransition() {
+    omnetpp::simtime_t now = omnetpp::simTime();
+    if (this->_transitionSearchTime >= SIMTIME_ZERO
+            && this->_transitionSearchTime <= now
+            && now < this->_nextTransition) {
+        return this->_nextTransition;
+    }
+
+    // the cylindrical shadow has a single boundary, the conical
+    // shadow one for the penumbra and one for the umbra
+    std::vector<double> boundaryFactors;
+    if (this->_shadowModel == SHADOW_CYLINDRICAL) {
+        boundaryFactors = { 0 };
+    } else {
+        boundaryFactors = { 1, -1 };
+    }
+
+    const double TOLERANCE = 1e-3; // in s
+    double start = now.dbl();
+    double end = start + this->_transitionSearchHorizon;
+    double transition = end;
+    for (double boundaryFactor : boundaryFactors) {
+        // bracket the first sign change by sampling, then bisect it
+        double t0 = start;
+        double f0 = this->shadowFunctionAt(t0, boundaryFactor);
+        while (t0 < transition) {
+            double t1 = std::min(t0 + this->_transitionSearchStep, transition);
+            double f1 = this->shadowFunctionAt(t1, boundaryFactor);
+            if ((f0 < 0) != (f1 < 0)) {
+                while (t1 - t0 > TOLERANCE) {
+                    double tm = (t0 + t1) / 2;
+                    double fm = this->shadowFunctionAt(tm, boundaryFactor);
+                    if ((fm < 0) == (f0 < 0)) {
+                        t0 = tm;
+                        f0 = fm;
+                    } else {
+                        t1 = tm;
+                    }
+                }
+                // end of the bracket lies on the new side of the boundary
+                transition = t1;
+                break;
+            }
+            t0 = t1;
+            f0 = f1;
+        }
+    }
+
+    this->_transitionSearchTime = now;
+    this->_nextTransition = std::max(omnetpp::simtime_t(transition),
+            now + omnetpp::SimTime(1, omnetpp::SIMTIME_MS));
+    EV_DEBUG << "Next shadow transition at " << this->_nextTransition
+                    << std::endl;
+    return this->_nextTransition;
+}
+
+double EnergyModule::getEarthRadius() {
+    if (this->_earthRadius < 0) {
+        inet::physicalenvironment::PhysicalEnvironment *pEnv =
+                omnetpp::check_and_cast<
+                        inet::physicalenvironment::PhysicalEnvironment*>(
+                        this->getSystemModule()->getSubmodule(
+                                "physicalEnvironment"));
+        const inet::Sphere *earth = omnetpp::check_and_cast<
+                const inet::Sphere*>(pEnv->getObject(0)->getShape());
+        this->_earthRadius = earth->getRadius();
+    }
+    return this->_earthRadius;
+}
+
+const EnergyModule::SunState& EnergyModule::getSunState() {
+    omnetpp::simtime_t now = omnetpp::simTime();
+    if (!this->_sunStateValid || this->_sunState.time != now) {
+        inet::Coord satPosition = this->_mobility->getCurrentPosition();
+        inet::Coord satSun = this->_sunPosition - satPosition;
+        this->_sunState.time = now;
+        this->_sunState.sunDirection = satSun / satSun.length();
+        this->_sunState.illumination = computeIllumination(satPosition,
+                this->_sunPosition, this->getEarthRadius(), this->_shadowModel);
+        this->_sunStateValid = true;
+        EV_DEBUG << "Illumination: " << this->_sunState.illumination
+                        << std::endl;
+    }
+    return this->_sunState;
+}
+
 bool EnergyModule::isInEclipse() {
-    // calculate sun sat line and check if it intersects with earth sphere
-    inet::LineSegment line = inet::LineSegment(
-            this->_mobility->getCurrentPosition() / 1000000 /*scaling by
-             1 million meter to prevent overflow*/, this->_sunPosition / 1000000);
-    inet::physicalenvironment::PhysicalEnvironment *pEnv =
-            omnetpp::check_and_cast<
-                    inet::physicalenvironment::PhysicalEnvironment*>(
-                    this->getSystemModule()->getSubmodule(
-                            "physicalEnvironment"));
-    const inet::ShapeBase *shape = pEnv->getObject(0)->getShape();
-    inet::Sphere *earth = const_cast<inet::Sphere*>(omnetpp::check_and_cast<
-            const inet::Sphere*>(shape));
-    earth->setRadius(earth->getRadius() / 1000000);
-    EV_DEBUG << "Radius: " << earth->getRadius() << "Line: ("
-                    << line.getPoint1().x << " , " << line.getPoint1().y
-                    << " , " << line.getPoint1().z << " ) - ( "
-                    << line.getPoint2().x << " , " << line.getPoint2().y
-                    << " , " << line.getPoint2().z << " )" << std::endl;
-    inet::Coord c1, c2, c3, c4;
-    bool rtn = earth->computeIntersection(line, c1, c2, c3, c4);
+    bool rtn = this->getSunState().illumination < 1;
     if (rtn)
         EV_DEBUG << "In Eclipse!" << std::endl;
-    earth->setRadius(earth->getRadius() * 1000000);
     return rtn;
 }
+
+double EnergyModule::getIllumination() {
+    return this->getSunState().illumination;
+}
+
+inet::Coord EnergyModule::getSunDirection() {
+    return this->getSunState().sunDirection;
+}
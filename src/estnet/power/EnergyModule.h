@@ -38,11 +38,67 @@ namespace estnet {
  */
 class ESTNET_API EnergyModule: public omnetpp::cModule {
 public:
+    /** @brief models of the Earth's shadow */
+    enum ShadowModel {
+        SHADOW_CYLINDRICAL, ///< sharp shadow, sun line of sight blocked by Earth
+        SHADOW_CONICAL      ///< umbra and penumbra from the apparent sun disk
+    };
+
+    /** @brief sun related state of the satellite at one point in time */
+    struct SunState {
+        omnetpp::simtime_t time;
+        inet::Coord sunDirection; ///< unit vector from satellite to sun in ECI
+        double illumination;      ///< visible fraction of the sun disk, 0 in umbra
+    };
+
+    /**
+     * Calculates the visible fraction of the sun disk at a position.
+     * Does not depend on any module state.
+     * @param satPosition: position of the satellite in ECI
+     * @param sunPosition: position of the sun in ECI
+     * @param earthRadius: radius of the Earth in m
+     * @param model: shadow model
+     * @return double: 1 in full sun, 0 in umbra, in between in penumbra
+     */
+    static double computeIllumination(const inet::Coord &satPosition,
+            const inet::Coord &sunPosition, double earthRadius,
+            ShadowModel model);
+
+    /**
+     * Shadow function whose roots are the shadow boundaries: the apparent
+     * separation of earth and sun minus the apparent earth radius plus
+     * boundaryFactor times the apparent sun radius, as seen from the
+     * satellite. Negative inside the respective shadow.
+     * @param boundaryFactor: 0 for the cylindrical shadow, 1 for the
+     *                        penumbra and -1 for the umbra boundary
+     */
+    static double computeShadowFunction(const inet::Coord &satPosition,
+            const inet::Coord &sunPosition, double earthRadius,
+            double boundaryFactor);
+
+    /** @brief predicts the next time the satellite enters or leaves
+     *         umbra or penumbra using the orbit propagation, cached until
+     *         the transition has passed
+     *  @return simtime_t: time of the transition, or the end of the search
+     *                     horizon if there is none before */
+    omnetpp::simtime_t getNextShadowTransition();
+
+    /** @brief returns the sun state of the satellite for the current
+     *         simulation time, computed once per time step and shared
+     *         by all solar panels */
+    const SunState& getSunState();
+
     /** @brief checks whether satellite in in Earth's shadow
-     *         by checking whether any power is generated
      *  @return bool: true if satellite is in eclipse */
     bool isInEclipse();
 
+    /** @brief returns the visible fraction of the sun disk
+     *  @return double: 1 in full sun, 0 in umbra */
+    double getIllumination();
+
+    /** @brief returns the unit vector from the satellite to the sun in ECI */
+    inet::Coord getSunDirection();
+
     /** gets the suns position in ECI frame
      *  which is used to calculate the suns illumination angle
      *  of the solar cells
@@ -56,12 +112,25 @@ protected:
      *  @param  stage: stage of initialization */
     virtual void initialize(int stage) override;
 
+    /** @brief returns the Earth radius of the physical environment */
+    double getEarthRadius();
+
 private:
     inet::Coord _sunPosition;   // suns coordinates in ECI, stays at this point
+    ShadowModel _shadowModel;
+    double _earthRadius = -1;   // read from the physical environment on first use
+    SunState _sunState;         // sun state of the last time step
+    bool _sunStateValid = false;
+    double _transitionSearchStep;    // sampling step to bracket transitions in s
+    double _transitionSearchHorizon; // how far transitions are predicted in s
+    omnetpp::simtime_t _transitionSearchTime = -1; // time of the last prediction
+    omnetpp::simtime_t _nextTransition;            // result of the last prediction
     IExtendedMobility *_mobility; // the satellites mobility
     bool _supplyConsumerDirectly;   // not used, intended to alter efficiencies
     int _checkInterval; // not used
 
+    /** @brief evaluates the shadow function at a future simulation time */
+    double shadowFunctionAt(double time, double boundaryFactor);
 };
 
 }  // namespace estnet
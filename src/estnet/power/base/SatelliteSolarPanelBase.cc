@@ -30,6 +30,8 @@ void SatelliteSolarPanelBase::initialize(int stage) {
         this->_numSolarCells = this->par("numSolarCells");
         this->_efficiency = this->par("efficiency").doubleValue();
         this->_checkIntervall = this->par("checkInterval");
+        this->_eventDriven = this->par("eventDriven");
+        this->_attitudeUpdateInterval = this->par("attitudeUpdateInterval");
         this->_systemLosses = this->par("systemLosses").doubleValue();
         this->_refractiveIndex = this->par("refractiveIndex").doubleValue();
         this->_absoluteSystemLoss = W(
@@ -62,7 +64,8 @@ void SatelliteSolarPanelBase::initialize(int stage) {
 
 W SatelliteSolarPanelBase::calculatePowerGeneration() {
     //check whether sat is in Eclipse
-    if (_energyModule->isInEclipse())
+    double illumination = _energyModule->getIllumination();
+    if (illumination <= 0)
         return W(0);
 
     // otherwise calculate the angle between sun and solar panel
@@ -71,7 +74,7 @@ W SatelliteSolarPanelBase::calculatePowerGeneration() {
     if ((sunAngle.get() > (-M_PI / 2)) && (sunAngle.get() < (M_PI / 2))) {
         //cosine model depending on how close the sun angle is to 90 deg
         double sunEfficiency = cos(sunAngle.get())
-                * (1 - calculateReflectivity(sunAngle));
+                * (1 - calculateReflectivity(sunAngle)) * illumination;
         //calculate energy produced
         W power = W(this->_sunIntensity.get() * this->_cellSize.get())
                 * sunEfficiency * this->_efficiency * this->_systemLosses
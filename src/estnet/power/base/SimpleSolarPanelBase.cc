@@ -28,6 +28,8 @@ void SimpleSolarPanelBase::initialize(int stage) {
         this->_maxOutputPower = W(this->par("maxOutputPower").doubleValue());
         this->_efficiency = this->par("efficiency").doubleValue();
         this->_checkIntervall = this->par("checkInterval");
+        this->_eventDriven = this->par("eventDriven");
+        this->_attitudeUpdateInterval = this->par("attitudeUpdateInterval");
         this->_energyModule = omnetpp::check_and_cast<EnergyModule*>(
                 this->getParentModule());
         const char *energySinkModule = par("energySinkModule");
@@ -55,7 +57,8 @@ void SimpleSolarPanelBase::initialize(int stage) {
 
 W SimpleSolarPanelBase::calculatePowerGeneration() {
     // check whether satellite is in Eclipse
-    if (_energyModule->isInEclipse())
+    double illumination = _energyModule->getIllumination();
+    if (illumination <= 0)
         return W(0);
 
     // otherwise calculate the angle between sun and solar panel
@@ -65,7 +68,7 @@ W SimpleSolarPanelBase::calculatePowerGeneration() {
     // if sun is shining at the upper side of the panel, calculate the power production
     if ((sunAngle.get() > (-M_PI / 2)) && (sunAngle.get() < (M_PI / 2))) {
         // cosine model depending on how close the sun angle is to 90 deg
-        double sunEfficiency = cos(sunAngle.get());
+        double sunEfficiency = cos(sunAngle.get()) * illumination;
         // calculate power produced
         W power = this->_maxOutputPower;
         power *= sunEfficiency;
@@ -18,6 +18,8 @@
 
 #include "SimpleEpBattery.h"
 
+#include <algorithm>
+
 using namespace estnet;
 
 Define_Module(SimpleEpBattery);
@@ -25,13 +27,109 @@ Define_Module(SimpleEpBattery);
 using namespace inet;
 using namespace power;
 
+void SimpleEpBattery::initialize(int stage) {
+    if (stage == INITSTAGE_LOCAL) {
+        // needed before the base class schedules the first timer
+        this->_eventDriven = par("eventDriven");
+    }
+    SimpleEpEnergyStorage::initialize(stage);
+    if (stage == INITSTAGE_LOCAL) {
+        // thresholds are given as state of charge, full and empty are always included
+        this->_thresholds.clear();
+        this->_thresholds.push_back(J(0));
+        for (double soc : cStringTokenizer(par("socThresholds")).asDoubleVector()) {
+            if (soc <= 0 || soc >= 1) {
+                throw cRuntimeError("State of charge threshold %g out of range (0, 1)",
+                        soc);
+            }
+            this->_thresholds.push_back(nominalCapacity * soc);
+        }
+        this->_thresholds.push_back(nominalCapacity);
+        std::sort(this->_thresholds.begin(), this->_thresholds.end());
+    }
+}
+
+void SimpleEpBattery::updateTotalPowerConsumption() {
+    if (this->_eventDriven) {
+        inet::units::values::W newTotal = inet::units::values::W(0);
+        for (auto consumer : energyConsumers) {
+            newTotal += consumer->getPowerConsumption();
+        }
+        // the scheduled event stays valid if nothing changed
+        if (newTotal == totalPowerConsumption) {
+            return;
+        }
+    }
+    SimpleEpEnergyStorage::updateTotalPowerConsumption();
+}
+
+void SimpleEpBattery::updateTotalPowerGeneration() {
+    if (this->_eventDriven) {
+        inet::units::values::W newTotal = inet::units::values::W(0);
+        for (auto generator : energyGenerators) {
+            newTotal += generator->getPowerGeneration();
+        }
+        // the scheduled event stays valid if nothing changed
+        if (newTotal == totalPowerGeneration) {
+            return;
+        }
+    }
+    SimpleEpEnergyStorage::updateTotalPowerGeneration();
+}
+
+void SimpleEpBattery::scheduleThresholdTimer() {
+    inet::units::values::W totalPower = totalPowerGeneration
+            - totalPowerConsumption;
+    if (timer->isScheduled())
+        cancelEvent(timer);
+    targetCapacity = residualCapacity;
+    if (totalPower > inet::units::values::W(0)) {
+        // first threshold above the residual capacity
+        auto it = std::upper_bound(this->_thresholds.begin(),
+                this->_thresholds.end(), residualCapacity);
+        if (it == this->_thresholds.end())
+            return;
+        targetCapacity = *it;
+    } else if (totalPower < inet::units::values::W(0)) {
+        // first threshold below the residual capacity
+        auto it = std::lower_bound(this->_thresholds.begin(),
+                this->_thresholds.end(), residualCapacity);
+        if (it == this->_thresholds.begin())
+            return;
+        targetCapacity = *std::prev(it);
+    } else {
+        return;
+    }
+    double remainingTime = unit((targetCapacity - residualCapacity) / totalPower
+            / inet::units::values::s(1)).get();
+    // stay within the simtime range, the timer is recalculated on expiry
+    if (remainingTime >= 10e5) {
+        remainingTime = 10e5;
+        targetCapacity = residualCapacity + totalPower
+                * inet::units::values::s(remainingTime);
+    }
+    scheduleAt(simTime() + remainingTime, timer);
+}
+
 void SimpleEpBattery::removeEnergyPortion(J energy) {
     EV_DEBUG << "Removed Energy Portion of: " << energy.get() << "J."
                     << std::endl;
+    if (this->_eventDriven) {
+        // the capacity is only integrated at events, so catch up first
+        // and move the threshold event according to the new capacity
+        this->updateResidualCapacity();
+        this->setResidualCapacity(this->residualCapacity - energy);
+        this->scheduleTimer();
+        return;
+    }
     this->setResidualCapacity(this->residualCapacity - energy);
 }
 
 void SimpleEpBattery::scheduleTimer() {
+    if (this->_eventDriven) {
+        this->scheduleThresholdTimer();
+        return;
+    }
     inet::units::values::W totalPower = totalPowerGeneration
             - totalPowerConsumption;
     targetCapacity = residualCapacity;
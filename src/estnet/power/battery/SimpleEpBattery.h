@@ -22,6 +22,8 @@
 #include <inet/power/storage/SimpleEpEnergyStorage.h>
 #include <inet/common/Units.h>
 
+#include <vector>
+
 #include "estnet/common/ESTNETDefs.h"
 
 using namespace omnetpp;
@@ -42,6 +44,25 @@ public:
 
     /** @brief same function as in inet, but without simtime bug */
     virtual void scheduleTimer() override;
+
+protected:
+    bool _eventDriven; // schedule only at thresholds and power changes
+    std::vector<J> _thresholds; // ascending capacities at which an event is scheduled
+
+    /** @brief initialization of the module, called by omnet
+     *  @param  stage: stage of initialization */
+    virtual void initialize(int stage) override;
+
+    /** @brief in event driven mode, only integrates and reschedules
+     *         if the total consumption actually changed */
+    virtual void updateTotalPowerConsumption() override;
+    /** @brief in event driven mode, only integrates and reschedules
+     *         if the total generation actually changed */
+    virtual void updateTotalPowerGeneration() override;
+
+    /** @brief schedules a single event at the next threshold crossing,
+     *         derived analytically from the current net power */
+    virtual void scheduleThresholdTimer();
 };
 
 }  // namespace estnet
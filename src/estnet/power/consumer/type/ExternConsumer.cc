@@ -44,7 +44,7 @@ void ExternConsumer::initialize(int stage) {
 }
 
 void ExternConsumer::receivedPubSubMessage(PubSubMsg *pubSubMsg) {
-    double dPower = atof((pubSubMsg->value).c_str());
+    double dPower = pubSubMsg->getNumber();
     this->_consumption = W(dPower);
     //publish power consumption
     EV << "Publishing a extern consume of " << _consumption.get() << std::endl;
@@ -18,6 +18,14 @@
 
 #include "ScheduledConsumer.h"
 
+#include <algorithm>
+#include <cerrno>
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+#include <tuple>
+
 using namespace estnet;
 
 Define_Module(ScheduledConsumer);
@@ -26,83 +34,207 @@ ScheduledConsumer::~ScheduledConsumer() {
     cancelAndDelete(this->_updateTimer);
 }
 
-void ScheduledConsumer::initialize(int stage) {
-    if (stage == inet::InitStages::INITSTAGE_PHYSICAL_OBJECT_CACHE) {
+/** @brief removes the entries of no longer used objects from a cache */
+template<typename tCache>
+static void pruneExpired(tCache &cache) {
+    for (auto it = cache.begin(); it != cache.end();) {
+        if (it->second.expired()) {
+            it = cache.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
 
-        _timestep = par("csvTimestep").doubleValueInUnit("s");
-        //read csv data and save as schedule
-        std::ifstream csvFile = std::ifstream(par("fileName").stringValue());
-        if (!csvFile.is_open())
-            EV_ERROR << "Consumption schedule not found" << omnetpp::endl;
-
-        char sep = ';';
-        // the first line has seperator information
-        if (csvFile.good()) {
-            std::string line;
-            std::getline(csvFile, line);
-            if (line.find(';') != std::string::npos) {
-                sep = ';';
-            } else if (line.find(',') != std::string::npos) {
-                sep = ',';
-            }
+std::shared_ptr<const ConsumptionScheduleFile> ScheduledConsumer::loadScheduleFile(
+        const std::string &fileName) {
+    static std::map<std::string, std::weak_ptr<const ConsumptionScheduleFile>> files;
+    auto cachedIt = files.find(fileName);
+    if (cachedIt != files.end()) {
+        auto cached = cachedIt->second.lock();
+        if (cached) {
+            return cached;
         }
-        std::string *titles = new std::string[100];
-        int numTitles = 0;
-        // read the first line containing the title of each cell
-        if (csvFile.good()) {
-            std::string line;
+    }
 
-            std::getline(csvFile, line);
-            std::stringstream lineStream(line);
+    // read the whole file at once and parse it in place, the text is
+    // released when the consumption changes are extracted
+    std::ifstream csvFile(fileName, std::ios::binary);
+    if (!csvFile.is_open()) {
+        throw cRuntimeError("Consumption schedule '%s' not found",
+                fileName.c_str());
+    }
+    auto file = std::make_shared<ConsumptionScheduleFile>();
+    std::string content;
+    {
+        std::stringstream buffer;
+        buffer << csvFile.rdbuf();
+        content = buffer.str();
+    }
 
-            while (std::getline(lineStream, titles[numTitles], sep)) {
-                numTitles++;
-            }
+    const char *pos = content.c_str();
+    const char *end = pos + content.length();
+    auto nextLine = [&pos, end](const char *&lineEnd) {
+        lineEnd = std::find(pos, end, '\n');
+        const char *line = pos;
+        pos = lineEnd == end ? end : lineEnd + 1;
+        // ignore windows line endings
+        if (lineEnd > line && *(lineEnd - 1) == '\r') {
+            lineEnd--;
         }
+        return line;
+    };
 
-        int csvColumn;
-        const char *columnName = par("columnName").stringValue();
-        for (int i = 0; i < numTitles; i++) {
-            if (titles[i].find(columnName) != std::string::npos) {
-                csvColumn = i;
-                break;
-            }
+    // the first line has seperator information
+    char sep = ';';
+    const char *lineEnd;
+    const char *line = nextLine(lineEnd);
+    if (std::find(line, lineEnd, ';') != lineEnd) {
+        sep = ';';
+    } else if (std::find(line, lineEnd, ',') != lineEnd) {
+        sep = ',';
+    }
+
+    // the second line contains the title of each cell
+    line = nextLine(lineEnd);
+    while (line <= lineEnd) {
+        const char *cellEnd = std::find(line, lineEnd, sep);
+        file->titles.emplace_back(line, cellEnd);
+        line = cellEnd + 1;
+    }
+    const size_t numColumns = file->titles.size();
+    file->columns.resize(numColumns);
+    // a column ends with its first empty or invalid cell
+    std::vector<bool> ended(numColumns, false);
+
+    int lineNo = 2;
+    size_t row = 0;
+    while (pos < end) {
+        line = nextLine(lineEnd);
+        lineNo++;
+        if (line == lineEnd) {
+            // skip empty lines
+            continue;
         }
-        delete[] titles;
-        std::string timeStr;
-        std::string consumptionStr;
-        double time = 0;
-        int counter = 0;
-        while (csvFile.good()) {
-            std::string line;
-            std::string *tokens = new std::string[100];
-            std::getline(csvFile, line);
-            std::stringstream lineStream(line);
-            int i = 0;
-            while (std::getline(lineStream, tokens[i], sep)) {
-                i++;
+        size_t column = 0;
+        while (line <= lineEnd) {
+            const char *cellEnd = std::find(line, lineEnd, sep);
+            if (column >= numColumns) {
+                // tolerate empty cells from trailing separators
+                if (cellEnd > line) {
+                    throw cRuntimeError(
+                            "Consumption schedule '%s' line %d: more than %d columns",
+                            fileName.c_str(), lineNo, (int) numColumns);
+                }
+            } else {
+                if (cellEnd == line) {
+                    ended[column] = true;
+                } else if (!ended[column]) {
+                    // the separator or line end stops strtod, only a cell
+                    // of blanks lets it continue on the next line
+                    char *parsedEnd;
+                    errno = 0;
+                    double c = strtod(line, &parsedEnd);
+                    while (parsedEnd < cellEnd
+                            && (*parsedEnd == ' ' || *parsedEnd == '\t')) {
+                        parsedEnd++;
+                    }
+                    ConsumptionScheduleColumn &scheduleColumn =
+                            file->columns[column];
+                    if (parsedEnd == line || parsedEnd != cellEnd
+                            || errno == ERANGE) {
+                        scheduleColumn.invalidLine = lineNo;
+                        scheduleColumn.invalidCell.assign(line, cellEnd);
+                        ended[column] = true;
+                    } else if (scheduleColumn.changes.empty()
+                            || scheduleColumn.changes.back().consumption != c) {
+                        // only store changes of the consumption
+                        scheduleColumn.changes.push_back( { row, c });
+                    }
+                }
+                column++;
             }
-            if (tokens[csvColumn].empty()) {
-                delete[] tokens;
-                break;
-            }
-            ConsumptionProperties cons;
-            double c = std::stod(tokens[csvColumn]);
+            line = cellEnd + 1;
+        }
+        // rows with missing trailing cells end these columns
+        for (; column < numColumns; column++) {
+            ended[column] = true;
+        }
+        row++;
+    }
+
+    pruneExpired(files);
+    files[fileName] = file;
+    return file;
+}
 
-            cons.time = time;
-            cons.consumption = W(c);
-            cons.on = c > 0;
+std::shared_ptr<const ScheduledConsumer::tSchedule> ScheduledConsumer::loadSchedule(
+        const std::string &fileName, const std::string &columnName,
+        double timestep) {
+    typedef std::tuple<std::string, std::string, double> tScheduleKey;
+    static std::map<tScheduleKey, std::weak_ptr<const tSchedule>> schedules;
+    tScheduleKey key(fileName, columnName, timestep);
+    auto cachedIt = schedules.find(key);
+    if (cachedIt != schedules.end()) {
+        auto cached = cachedIt->second.lock();
+        if (cached) {
+            return cached;
+        }
+    }
 
-            this->_scheduledConsumption.push_back(cons);
-            time += _timestep;
-            counter++;
+    auto file = loadScheduleFile(fileName);
+    size_t csvColumn = file->titles.size();
+    for (size_t i = 0; i < file->titles.size(); i++) {
+        if (file->titles[i].find(columnName) != std::string::npos) {
+            csvColumn = i;
+            break;
         }
-        csvFile.close();
+    }
+    if (csvColumn == file->titles.size()) {
+        throw cRuntimeError("Consumption schedule '%s' has no column '%s'",
+                fileName.c_str(), columnName.c_str());
+    }
+
+    const ConsumptionScheduleColumn &column = file->columns[csvColumn];
+    if (column.invalidLine > 0) {
+        throw cRuntimeError(
+                "Consumption schedule '%s' line %d column %d: invalid number '%s'",
+                fileName.c_str(), column.invalidLine, (int) csvColumn + 1,
+                column.invalidCell.c_str());
+    }
+    if (column.changes.empty()) {
+        throw cRuntimeError("Consumption schedule '%s' column '%s' is empty",
+                fileName.c_str(), columnName.c_str());
+    }
+
+    auto schedule = std::make_shared<tSchedule>();
+    schedule->reserve(column.changes.size());
+    for (const ConsumptionChange &change : column.changes) {
+        ConsumptionProperties cons;
+        cons.time = change.row * timestep;
+        cons.consumption = W(change.consumption);
+        cons.on = change.consumption > 0;
+        schedule->push_back(cons);
+    }
+
+    pruneExpired(schedules);
+    schedules[key] = schedule;
+    return schedule;
+}
+
+void ScheduledConsumer::initialize(int stage) {
+    if (stage == inet::InitStages::INITSTAGE_PHYSICAL_OBJECT_CACHE) {
+
+        _timestep = par("csvTimestep").doubleValueInUnit("s");
+        //read csv data and save as schedule
+        this->_scheduleFile = loadScheduleFile(par("fileName").stdstringValue());
+        this->_scheduledConsumption = loadSchedule(par("fileName").stdstringValue(),
+                par("columnName").stdstringValue(), this->_timestep);
 
         //initialize with first consumption value and schedule the next change
         this->_updateTimer = new cMessage("update power consumption");
-        this->_currentSchedule = this->_scheduledConsumption.begin();
-        scheduleAt(SimTime(this->_currentSchedule->time, SIMTIME_S),
+        this->_currentSchedule = 0;
+        scheduleAt(SimTime(this->_scheduledConsumption->front().time, SIMTIME_S),
                 this->_updateTimer);
 
         //get consumer module
@@ -110,9 +242,30 @@ void ScheduledConsumer::initialize(int stage) {
         this->_energyConsumer = check_and_cast<ConsumerModuleBase*>(
                 getModuleByPath(consumerModule));
 
-    } else if (stage == 5)
+    } else if (stage == 5) {
         _energyConsumer->addStateHandler(this);
+        // all consumers read their schedules, the file is no longer needed
+        this->_scheduleFile.reset();
+    }
+
+}
 
+size_t ScheduledConsumer::findScheduleEntry(const tSchedule &schedule,
+        size_t cursor, double time) {
+    // usually the time is the one of the current or the next entry
+    if (cursor < schedule.size() && schedule[cursor].time <= time
+            && (cursor + 1 == schedule.size() || time < schedule[cursor + 1].time)) {
+        return cursor;
+    }
+    if (cursor + 1 < schedule.size() && schedule[cursor + 1].time <= time
+            && (cursor + 2 == schedule.size() || time < schedule[cursor + 2].time)) {
+        return cursor + 1;
+    }
+    auto it = std::upper_bound(schedule.begin(), schedule.end(), time,
+            [](double t, const ConsumptionProperties &entry) {
+                return t < entry.time;
+            });
+    return it == schedule.begin() ? 0 : it - schedule.begin() - 1;
 }
 
 void ScheduledConsumer::handleMessage(cMessage *msg) {
@@ -120,20 +273,25 @@ void ScheduledConsumer::handleMessage(cMessage *msg) {
         //get next scheduled power consumption planned for the time, when the timer was scheduled
         this->updatePowerConsumption();
         //schedule the next change
-        if (this->_currentSchedule != this->_scheduledConsumption.end())
-            scheduleAt(SimTime(this->_currentSchedule->time, SIMTIME_S), msg);
+        if (this->_currentSchedule < this->_scheduledConsumption->size())
+            scheduleAt(SimTime((*this->_scheduledConsumption)[this->_currentSchedule].time,
+                    SIMTIME_S), msg);
     }
 }
 
 void ScheduledConsumer::updatePowerConsumption() {
+    const ConsumptionProperties &entry =
+            (*this->_scheduledConsumption)[findScheduleEntry(
+                    *this->_scheduledConsumption, this->_currentSchedule,
+                    simTime().dbl())];
     //switch the state
-    this->_on = this->_currentSchedule->on;
+    this->_on = entry.on;
     //get next scheduled consumption and publish it
-    this->_powerConsumption = this->_currentSchedule->consumption;
+    this->_powerConsumption = entry.consumption;
     EV_DEBUG << "Publishing a scheduled consume of " << this->_powerConsumption
                     << std::endl;
     this->_energyConsumer->powerConsumptionChanged();
-    //increment the iterator for next consumption
-    this->_currentSchedule++;
+    //move the cursor to the next consumption
+    this->_currentSchedule = (&entry - this->_scheduledConsumption->data()) + 1;
 }
 
@@ -20,9 +20,9 @@
 #define ESTNET_POWER_CONSUMER_TYPE_SCHEDULEDCONSUMER_H_
 
 #include <map>
-#include <fstream>
-#include <iostream>
+#include <memory>
 #include <string>
+#include <vector>
 
 #include <inet/power/contract/IEpEnergyConsumer.h>
 #include <inet/common/Units.h>
@@ -37,6 +37,36 @@ struct ConsumptionProperties {
     bool on;
 };
 
+/** @brief change of the consumption in a column of a schedule file */
+struct ConsumptionChange {
+    size_t row;         ///< data row of the change
+    double consumption; ///< consumption from this row on in W
+};
+
+/** @brief consumption changes of one column of a schedule file */
+struct ConsumptionScheduleColumn {
+    /// changes up to the first empty or invalid cell
+    std::vector<ConsumptionChange> changes;
+    /// line of the first invalid cell, 0 if there is none
+    int invalidLine = 0;
+    /// text of the first invalid cell
+    std::string invalidCell;
+};
+
+/**
+ * Contents of a schedule csv file, parsed into the consumption changes of
+ * every column in a single pass without keeping the text of the file.
+ * Invalid numbers are only reported when a consumer selects their column,
+ * so other columns may contain arbitrary text like labels or timestamps.
+ * Files are shared by all consumers that read them.
+ */
+struct ConsumptionScheduleFile {
+    /// titles of the columns
+    std::vector<std::string> titles;
+    /// consumption changes of each column
+    std::vector<ConsumptionScheduleColumn> columns;
+};
+
 /**
  * Scheduled consumer is reading in a .csv file.
  * This file is containing all relevant consumptions
@@ -48,9 +78,14 @@ struct ConsumptionProperties {
  *  10,0,0
  *  20,1,1
  *  30,1,1"
+ * Consecutive rows with the same consumption are merged into a single
+ * entry of the schedule and identical schedules are shared between
+ * all satellites.
  */
 class ESTNET_API ScheduledConsumer: public ConsumerStateHandler {
 protected:
+    typedef std::vector<ConsumptionProperties> tSchedule;
+
     /** @brief initialize function
      *  @param  stage: stage of initialization */
     virtual void initialize(int stage) override;
@@ -62,14 +97,36 @@ protected:
     /** @brief change state and power consumption */
     virtual void updatePowerConsumption();
 
-    /// iterator for iterating over schedule
-    std::vector<ConsumptionProperties>::iterator _currentSchedule;
+    /** @brief returns the index of the schedule entry valid at the given
+     *         time, checking the entry at the cursor and the one after it
+     *         before searching the whole schedule */
+    static size_t findScheduleEntry(const tSchedule &schedule, size_t cursor,
+            double time);
+
+    /** @brief returns the parsed csv file, loading it if it is not
+     *         yet used by another consumer */
+    static std::shared_ptr<const ConsumptionScheduleFile> loadScheduleFile(
+            const std::string &fileName);
+
+    /** @brief returns the schedule for a column of a file with the
+     *         given timestep, creating it if it is not yet used by
+     *         another consumer */
+    static std::shared_ptr<const tSchedule> loadSchedule(
+            const std::string &fileName, const std::string &columnName,
+            double timestep);
+
+    /// index of the current entry in the schedule
+    size_t _currentSchedule = 0;
 
     /// schedule that is stored in a vector
-    std::vector<ConsumptionProperties> _scheduledConsumption;
+    std::shared_ptr<const tSchedule> _scheduledConsumption;
+
+    /// csv file of the schedule, held during initialization so that
+    /// consumers reading other columns of it do not parse it again
+    std::shared_ptr<const ConsumptionScheduleFile> _scheduleFile;
 
     /// message for scheduling next consumption change
-    cMessage *_updateTimer;
+    cMessage *_updateTimer = nullptr;
 
     /// timestep used in csv
     double _timestep;
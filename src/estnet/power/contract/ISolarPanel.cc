@@ -18,6 +18,8 @@
 
 #include "ISolarPanel.h"
 
+#include <algorithm>
+
 using namespace estnet;
 
 ISolarPanel::~ISolarPanel() {
@@ -29,11 +31,26 @@ void ISolarPanel::handleMessage(omnetpp::cMessage *message) {
     if (message == this->_checkTimer) {
         //publish energy produced
         updatePowerGeneration();
-        this->scheduleAt(omnetpp::simTime() + this->_checkIntervall,
-                this->_checkTimer);
+        this->scheduleNextUpdate();
     }
 }
 
+void ISolarPanel::scheduleNextUpdate() {
+    omnetpp::simtime_t next = omnetpp::simTime() + this->_checkIntervall;
+    if (this->_eventDriven) {
+        // the illumination only changes at the shadow boundaries and
+        // continuously within the penumbra, everywhere else only the
+        // attitude changes the generated power
+        double illumination = this->_energyModule->getIllumination();
+        if (illumination <= 0 || illumination >= 1) {
+            next = omnetpp::simTime() + this->_attitudeUpdateInterval;
+        }
+        // within the penumbra keep sampling, but never miss the boundary
+        next = std::min(next, this->_energyModule->getNextShadowTransition());
+    }
+    this->scheduleAt(next, this->_checkTimer);
+}
+
 int ISolarPanel::numInitStages() const {
     return inet::InitStages::NUM_INIT_STAGES;
 }
@@ -47,13 +64,8 @@ W ISolarPanel::getPowerGeneration() const {
 }
 
 rad ISolarPanel::getSunAngle() {
-    auto energyModule = omnetpp::check_and_cast<EnergyModule*>(
-            this->getParentModule());
-
-    // calculate sun vector
-    inet::Coord vecSatSun = energyModule->getSunPosition()
-            - this->_mobility->getCurrentPosition();
-    vecSatSun = vecSatSun / 100000000.0; //scaling to prevent overflow
+    // sun vector, shared by all panels of the satellite
+    inet::Coord vecSatSun = this->_energyModule->getSunDirection();
 
     // calculate angle between solarPanel and sun vector
     inet::Coord normalVecPanelInWorldFrame; //= inet::Coord();
@@ -72,7 +84,7 @@ rad ISolarPanel::getSunAngle() {
 
     //double angle = normalVecPanelInWorldFrame.angle(vecSatSun);
     double normedScalarProduct = vecSatSun * normalVecPanelInWorldFrame
-            / normalVecPanelInWorldFrame.length() / vecSatSun.length();
+            / normalVecPanelInWorldFrame.length();
     bool checkForInvalidData = normedScalarProduct > 1.0
             || normedScalarProduct < -1.0;
     double angle;
@@ -59,6 +59,12 @@ protected:
 
     W _currentPower;            ///< power produced at the moment
     omnetpp::cMessage *_checkTimer;
+    bool _eventDriven = false;  ///< update at eclipse transitions instead of polling
+    omnetpp::simtime_t _attitudeUpdateInterval; ///< update interval in event driven mode
+
+    /** @brief schedules the next power update, either after the check
+     *         interval or at the next eclipse transition */
+    virtual void scheduleNextUpdate();
 
     /** @brief calculates angle between sun vector and solar panel pointing vector
      *  @return rad: sun illumination angle */
@@ -31,30 +31,42 @@ namespace estnet {
 
 omnetpp::cMessage* ExternalProtocolModuleBase::recvFromProtocol() {
     // receive from protocol
-    std::string commandString;
-    this->recvFromProtocol(commandString);
+    size_t commandLength;
+    char *command = this->recvCommandFromProtocol(commandLength);
     std::cout << "Node " << this->_nodeNo
-            << ": received command string from protocol '" << commandString
-            << "' (" << commandString.length() << ")" << std::endl;
-    // parse received command string
+            << ": received command string from protocol '" << command
+            << "' (" << commandLength << ")" << std::endl;
+    // parse received command string in place
     rapidjson::Document d;
-    d.Parse(commandString.c_str());
-    if (std::string(d["command"].GetString()) == std::string("send")) {
+    d.ParseInsitu(command);
+    if (d.HasParseError() || !d.HasMember("command")) {
+        throw omnetpp::cRuntimeError("Invalid command received");
+    }
+    const char *commandName = d["command"].GetString();
+    if (strcmp(commandName, "send") == 0) {
         return this->getRadioFrame(d);
-    } else if (std::string(d["command"].GetString())
-            == std::string("receive")) {
+    } else if (strcmp(commandName, "receive") == 0) {
         return this->getAppPacket(d);
-    } else if (std::string(d["command"].GetString())
-            == std::string("receiveRoutingTable")) {
+    } else if (strcmp(commandName, "receiveRoutingTable") == 0) {
         return this->getAppPacket(d);
-    } else if (std::string(d["command"].GetString())
-            == std::string("buffered")) {
+    } else if (strcmp(commandName, "buffered") == 0) {
         return this->getTimeoutMessage(d);
+    } else if (strcmp(commandName, "abandoned") == 0) {
+        return this->getAbandonedMessage(d);
     } else {
         throw omnetpp::cRuntimeError("Unknown command received");
     }
 }
 
+char* ExternalProtocolModuleBase::recvCommandFromProtocol(size_t &length) {
+    std::string commandString;
+    this->recvFromProtocol(commandString);
+    length = commandString.length();
+    this->_commandBuffer.assign(commandString.begin(), commandString.end());
+    this->_commandBuffer.push_back('\0');
+    return &this->_commandBuffer[0];
+}
+
 void ExternalProtocolModuleBase::sendTimeToProtocol() {
     std::string commandString;
     this->buildTimeCommand(std::string("timeSync"), commandString);
@@ -229,12 +241,27 @@ void ExternalProtocolModuleBase::buildReceiveCommand(const std::string &command,
 
 omnetpp::cMessage* ExternalProtocolModuleBase::getTimeoutMessage(
         rapidjson::Document &d) {
-    omnetpp::cMessage *bufferedTimeout = new omnetpp::cMessage(
-            "bufferedTimeout", PROTOCOL_MODULE_BUFFER_TIMEOUT);
+    omnetpp::cMessage *bufferedTimeout;
+    if (d.HasMember("sourceNodeNo") && d.HasMember("sequenceNumber")) {
+        bufferedTimeout = new BufferTimeoutMessage("bufferedTimeout",
+                d["sourceNodeNo"].GetUint(),
+                (long) d["sequenceNumber"].GetUint64());
+    } else {
+        // older protocol implementations do not identify the buffered packet
+        bufferedTimeout = new omnetpp::cMessage("bufferedTimeout",
+                PROTOCOL_MODULE_BUFFER_TIMEOUT);
+    }
     bufferedTimeout->setTimestamp(omnetpp::SimTime(d["ut"].GetUint64()));
     return bufferedTimeout;
 }
 
+omnetpp::cMessage* ExternalProtocolModuleBase::getAbandonedMessage(
+        rapidjson::Document &d) {
+    return new BufferTimeoutMessage("abandoned", d["sourceNodeNo"].GetUint(),
+            (long) d["sequenceNumber"].GetUint64(),
+            PROTOCOL_MODULE_PACKET_THROWAWAY);
+}
+
 inet::Packet* ExternalProtocolModuleBase::getRadioFrame(
         rapidjson::Document &d) {
 
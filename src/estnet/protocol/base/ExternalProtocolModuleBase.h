@@ -21,6 +21,7 @@
 
 #include <tuple>
 #include <map>
+#include <vector>
 #include <rapidjson/document.h>
 
 #include <inet/common/packet/Packet.h>
@@ -47,6 +48,15 @@ protected:
     virtual void sendToProtocol(const std::string &commandString) = 0;
     /** @brief receives a command from the external protocol process */
     virtual void recvFromProtocol(std::string &commandString) = 0;
+    /**
+     * receives a command from the external protocol process into a
+     * buffer, which may be modified for in situ parsing.
+     * The default implementation copies the result of
+     * @recvFromProtocol(std::string&) into a buffer kept by this module.
+     * @param length set to the length of the command without terminator
+     * @returns null terminated command, valid until the next call
+     */
+    virtual char* recvCommandFromProtocol(size_t &length);
 
     /**
      * Base implementation provided to all implementations
@@ -112,6 +122,8 @@ protected:
             size_t payloadSize, std::string &commandString);
     /** @brief builds a buffer timeout response for ~ProtocolModuleBase */
     virtual omnetpp::cMessage* getTimeoutMessage(rapidjson::Document &d);
+    /** @brief builds the response for a buffered packet the protocol abandoned */
+    virtual omnetpp::cMessage* getAbandonedMessage(rapidjson::Document &d);
     /** @brief builds the respective radio frame for a 'send packet' response from the protocol */
     virtual inet::Packet* getRadioFrame(rapidjson::Document &d);
     /** @brief grabs the respective app packet for a 'receive packet' response from the protocol */
@@ -121,6 +133,7 @@ protected:
         return false;
     }
 private:
+    std::vector<char> _commandBuffer;
     std::map<SequenceNumber, inet::Packet*> _appPackets;
     std::map<SequenceNumber, inet::Packet*> _radioFrames;
 };
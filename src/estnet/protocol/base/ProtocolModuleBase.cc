@@ -72,6 +72,7 @@ void ProtocolModuleBase::initialize(int stage) {
         this->_nodeNo = this->par("nodeNo");
         this->_dropAlreadySeenFrames =
                 this->par("dropAlreadySeenFrames").boolValue();
+        this->_bufferTimer = new omnetpp::cMessage("bufferTimeout");
     } else if (stage == 2) {
         /*if (this->par("fakeSentRoutingTable").boolValue()) {
          this->sendRoutingTableToProtocol(
@@ -81,6 +82,7 @@ void ProtocolModuleBase::initialize(int stage) {
 }
 
 ProtocolModuleBase::~ProtocolModuleBase() {
+    this->cancelAndDelete(this->_bufferTimer);
 }
 
 void ProtocolModuleBase::sendToApp(omnetpp::cMessage *message) {
@@ -102,23 +104,70 @@ void ProtocolModuleBase::handleMessage(omnetpp::cMessage *message) {
         // we got a new frame to be handled from the lower layer
         this->receivedFromRadio(
                 omnetpp::check_and_cast<inet::Packet*>(message));
-    } else if (contains(this->_bufferedTimeouts, message)) {
-        // we got a buffer timeout, we'll wait for the packet to arrive from the protocol buffer
-        this->handleBufferTimeout(message);
+    } else if (message == this->_bufferTimer) {
+        // release all packets whose buffer timeout expired, in order of their timeout
+        // handling a timeout might buffer further packets, so always take the earliest
+        while (!this->_bufferExpiries.empty()
+                && std::get<0>(*this->_bufferExpiries.begin())
+                        <= omnetpp::simTime()) {
+            BufferedPacketKey key = std::get<1>(*this->_bufferExpiries.begin());
+            this->releaseBufferedPacket(key);
+            this->handleBufferTimeout();
+        }
+        this->rescheduleBufferTimer();
     } else {
         throw omnetpp::cRuntimeError("Unexpected message received");
     }
 }
 
-void ProtocolModuleBase::handleBufferTimeout(omnetpp::cMessage *message) {
-    auto bufIt = std::find(this->_bufferedTimeouts.begin(),
-            this->_bufferedTimeouts.end(), message);
-    this->_bufferedTimeouts.erase(bufIt);
-    this->cancelAndDelete(message);
+void ProtocolModuleBase::handleBufferTimeout() {
+    // we'll wait for the packet to arrive from the protocol buffer
     this->sendTimeToProtocol();
     this->waitForProtocolResponse(nullptr);
+}
+
+void ProtocolModuleBase::bufferPacketUntil(const BufferedPacketKey &key,
+        omnetpp::simtime_t timeout) {
+    auto bufIt = this->_bufferedTimeouts.find(key);
+    if (bufIt != this->_bufferedTimeouts.end()) {
+        // the protocol updated the timeout of an already buffered packet
+        this->_bufferExpiries.erase(std::make_tuple(bufIt->second, key));
+        bufIt->second = timeout;
+    } else {
+        this->_bufferedTimeouts.emplace(key, timeout);
+    }
+    this->_bufferExpiries.emplace(timeout, key);
+    this->rescheduleBufferTimer();
+    // buffer statistics collection
+    emit(bufferLength, (unsigned long int) this->getBufferOccupancy());
+}
+
+bool ProtocolModuleBase::releaseBufferedPacket(const BufferedPacketKey &key) {
+    auto bufIt = this->_bufferedTimeouts.find(key);
+    if (bufIt == this->_bufferedTimeouts.end()) {
+        return false;
+    }
+    this->_bufferExpiries.erase(std::make_tuple(bufIt->second, key));
+    this->_bufferedTimeouts.erase(bufIt);
     // buffer statistics collection
-    emit(bufferLength, (unsigned long int) this->_bufferedTimeouts.size());
+    emit(bufferLength, (unsigned long int) this->getBufferOccupancy());
+    return true;
+}
+
+void ProtocolModuleBase::rescheduleBufferTimer() {
+    if (this->_bufferExpiries.empty()) {
+        this->cancelEvent(this->_bufferTimer);
+        return;
+    }
+    omnetpp::simtime_t nextTimeout = std::max(
+            std::get<0>(*this->_bufferExpiries.begin()), omnetpp::simTime());
+    if (this->_bufferTimer->isScheduled()) {
+        if (this->_bufferTimer->getArrivalTime() == nextTimeout) {
+            return;
+        }
+        this->cancelEvent(this->_bufferTimer);
+    }
+    this->scheduleAt(nextTimeout, this->_bufferTimer);
 }
 
 void ProtocolModuleBase::receivedFromApp(inet::Packet *appPkt) {
@@ -154,17 +203,28 @@ void ProtocolModuleBase::waitForProtocolResponse(
     omnetpp::cMessage *message = this->recvFromProtocol();
     if (message->getKind() == PROTOCOL_MODULE_PACKET_THROWAWAY) {
         emit(droppedPk, argMessage);
+        // a buffered packet might have been abandoned by the protocol
+        BufferTimeoutMessage *abandoned =
+                dynamic_cast<BufferTimeoutMessage*>(message);
+        if (abandoned != nullptr) {
+            this->releaseBufferedPacket(abandoned->getKey());
+        }
         // argMessage will be dropped by our caller, so we're just deleting the message
         delete message;
         return;
     } else if (message->getKind() == PROTOCOL_MODULE_BUFFER_TIMEOUT) {
-        // schedule the message for later, when the packet will be removed from the buffer
+        // remember the packet until it will be removed from the buffer
         omnetpp::SimTime timeout = message->getTimestamp();
-        message->setTimestamp();
-        this->_bufferedTimeouts.push_back(message);
-        this->scheduleAt(timeout, message);
+        BufferTimeoutMessage *bufferTimeout =
+                dynamic_cast<BufferTimeoutMessage*>(message);
+        BufferedPacketKey key =
+                bufferTimeout != nullptr ?
+                        bufferTimeout->getKey() :
+                        std::make_tuple(this->_nodeNo,
+                                this->_nextAnonymousBufferId--);
+        delete message;
+        this->bufferPacketUntil(key, timeout);
         // buffer statistics collection
-        emit(bufferLength, (unsigned long int) this->_bufferedTimeouts.size());
         emit(bufferingTime, timeout - omnetpp::simTime());
 
         return;
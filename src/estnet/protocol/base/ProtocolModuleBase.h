@@ -22,6 +22,7 @@
 #include <omnetpp.h>
 #include <tuple>
 #include <set>
+#include <unordered_map>
 #include <vector>
 
 #include "estnet/protocol/contract/IProtocolModule.h"
@@ -31,6 +32,42 @@ namespace estnet {
 const short PROTOCOL_MODULE_BUFFER_TIMEOUT = 3;
 const short PROTOCOL_MODULE_PACKET_THROWAWAY = 4;
 
+/** identifies a buffered packet by its source node and sequence number */
+typedef std::tuple<unsigned int, long> BufferedPacketKey;
+
+/** @brief hash for ~BufferedPacketKey, so it can be used in unordered containers */
+struct BufferedPacketKeyHash {
+    size_t operator()(const BufferedPacketKey &key) const {
+        return std::hash<unsigned long long>()(
+                ((unsigned long long) std::get<0>(key) << 40)
+                        ^ (unsigned long long) std::get<1>(key));
+    }
+};
+
+/**
+ * Response of a protocol to announce that a packet got buffered
+ * (PROTOCOL_MODULE_BUFFER_TIMEOUT) or abandoned (PROTOCOL_MODULE_PACKET_THROWAWAY).
+ * The timestamp holds the time until which the packet is buffered,
+ * source node and sequence number identify the packet, so that
+ * later updates replace the earlier timeout.
+ */
+class ESTNET_API BufferTimeoutMessage: public omnetpp::cMessage {
+public:
+    BufferTimeoutMessage(const char *name, unsigned int sourceNodeNo,
+            long sequenceNumber, short kind = PROTOCOL_MODULE_BUFFER_TIMEOUT) :
+            omnetpp::cMessage(name, kind), _key(
+                    sourceNodeNo, sequenceNumber) {
+    }
+    virtual BufferTimeoutMessage* dup() const override {
+        return new BufferTimeoutMessage(*this);
+    }
+    const BufferedPacketKey& getKey() const {
+        return this->_key;
+    }
+private:
+    BufferedPacketKey _key;
+};
+
 /**
  * Augments @IProtocolModule with methods
  * to handle the interaction with connected
@@ -143,7 +180,21 @@ protected:
     /** @brief called to deliver a frame to a radio */
     virtual void sendToRadio(inet::Packet *frame);
 
-    virtual void handleBufferTimeout(omnetpp::cMessage *message);
+    /** @brief called when the buffer timeout of a packet expired */
+    virtual void handleBufferTimeout();
+
+    /** @brief buffers the given packet until timeout, replacing any
+     *  earlier timeout of the same packet */
+    virtual void bufferPacketUntil(const BufferedPacketKey &key,
+            omnetpp::simtime_t timeout);
+    /** @brief removes the given packet from the buffer without waiting
+     *  for its timeout, e.g. because it got abandoned
+     *  @returns true if the packet was buffered */
+    virtual bool releaseBufferedPacket(const BufferedPacketKey &key);
+    /** @brief returns the number of packets currently buffered */
+    size_t getBufferOccupancy() const {
+        return this->_bufferedTimeouts.size();
+    }
 
     /** @brief waits until the protocol responds to a frame or packet
      *  and then calls the appriopriate received functions
@@ -168,8 +219,19 @@ protected:
     std::set<std::tuple<unsigned int, long>> _seenPackets;
     bool _dropAlreadySeenFrames;
 private:
+    /** @brief schedules the buffer timer for the earliest buffer timeout */
+    void rescheduleBufferTimer();
+
     long _nextPacketSequenceNumber = 1;
-    std::vector<omnetpp::cMessage*> _bufferedTimeouts;
+    /** key of packets not identified by the protocol, counting downwards */
+    long _nextAnonymousBufferId = -1;
+    /** buffer timeout for each buffered packet */
+    std::unordered_map<BufferedPacketKey, omnetpp::simtime_t,
+            BufferedPacketKeyHash> _bufferedTimeouts;
+    /** buffered packets ordered by their timeout */
+    std::set<std::tuple<omnetpp::simtime_t, BufferedPacketKey>> _bufferExpiries;
+    /** single self message for the earliest buffer timeout */
+    omnetpp::cMessage *_bufferTimer = nullptr;
 };
 
 }  // namespace estnet
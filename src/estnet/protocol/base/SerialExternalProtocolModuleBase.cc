@@ -18,6 +18,8 @@
 
 #include "SerialExternalProtocolModuleBase.h"
 
+#include <algorithm>
+
 #include "estnet/common/ByteHelpers.h"
 
 namespace estnet {
@@ -35,6 +37,7 @@ void SerialExternalProtocolModuleBase::disconnect() {
         delete this->_serial;
         this->_serial = nullptr;
     }
+    this->_rxBuffer.clear();
 }
 
 void SerialExternalProtocolModuleBase::sendToProtocol(
@@ -55,27 +58,35 @@ void SerialExternalProtocolModuleBase::sendToProtocol(
 }
 
 bool SerialExternalProtocolModuleBase::dataFromProtocol() {
-    return this->_serial->available() > 0;
+    // a previous read might already have received the next command
+    return this->_rxBuffer.hasFrame() || this->_serial->available() > 0;
+}
+
+char* SerialExternalProtocolModuleBase::recvCommandFromProtocol(
+        size_t &length) {
+    char *command;
+    while (!this->_rxBuffer.nextFrame(command, length)) {
+        // read everything available, but block for at least one byte
+        size_t toRead = std::max<size_t>(1, this->_serial->available());
+        size_t available;
+        uint8_t *buffer = (uint8_t*) this->_rxBuffer.prepareWrite(toRead,
+                available);
+        size_t received = this->_serial->read(buffer,
+                std::min(toRead, available));
+        if (received == 0) {
+            throw omnetpp::cRuntimeError(
+                    "Could not receive command string from protocol");
+        }
+        this->_rxBuffer.commitWrite(received);
+    }
+    return command;
 }
 
 void SerialExternalProtocolModuleBase::recvFromProtocol(
         std::string &commandString) {
-    const size_t bufferSize = UINT16_MAX;
-    uint8_t buffer[bufferSize];
-    memset(buffer, '\0', bufferSize);
-    size_t commandStringLength = 0;
-    // receive length of the command string
-    this->_serial->read(buffer, 2);
-    // convert length from bytes to int
-    commandStringLength = bytesToUint16(buffer);
-    // receive actual command string
-    if (commandStringLength >= bufferSize) {
-        throw omnetpp::cRuntimeError("Command string to long for buffer");
-    }
-    // receive actual command string
-    this->_serial->read(buffer, commandStringLength);
-    buffer[commandStringLength] = '\0';
-    commandString = std::string((char*) buffer);
+    size_t commandStringLength;
+    char *command = this->recvCommandFromProtocol(commandStringLength);
+    commandString.assign(command, commandStringLength);
 }
 
 }  // namespace estnet
@@ -22,6 +22,7 @@
 #include <serial/serial.h>
 
 #include "ExternalProtocolModuleBase.h"
+#include "estnet/common/FrameReceiveBuffer.h"
 
 namespace estnet {
 
@@ -42,8 +43,12 @@ protected:
     virtual void sendToProtocol(const std::string &commandString) override;
     /** @brief receives a byte string from the serial port */
     virtual void recvFromProtocol(std::string &commandString) override;
+    /** @brief receives a command from the serial port into the receive buffer */
+    virtual char* recvCommandFromProtocol(size_t &length) override;
 private:
-    serial::Serial *_serial;
+    serial::Serial *_serial = nullptr;
+    // kept for the whole connection, a read may return several commands
+    FrameReceiveBuffer _rxBuffer;
 };
 
 }  // namespace estnet
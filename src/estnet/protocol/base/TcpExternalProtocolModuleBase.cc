@@ -33,6 +33,7 @@ bool TcpExternalProtocolModuleBase::connect(const std::string &host, int port) {
 void TcpExternalProtocolModuleBase::disconnect() {
     close_socket(this->_sockfd);
     this->_sockfd = -1;
+    this->_rxBuffer.clear();
 }
 
 void TcpExternalProtocolModuleBase::sendToProtocol(
@@ -54,28 +55,32 @@ void TcpExternalProtocolModuleBase::sendToProtocol(
 }
 
 bool TcpExternalProtocolModuleBase::dataFromProtocol() {
-    return checkIfDataAvailable(this->_sockfd) > 0;
+    // a previous read might already have received the next command
+    return this->_rxBuffer.hasFrame()
+            || checkIfDataAvailable(this->_sockfd) > 0;
+}
+
+char* TcpExternalProtocolModuleBase::recvCommandFromProtocol(size_t &length) {
+    char *command;
+    while (!this->_rxBuffer.nextFrame(command, length)) {
+        // read whatever is available, this may be a partial command or several
+        size_t available;
+        char *buffer = this->_rxBuffer.prepareWrite(4096, available);
+        ssize_t received = recv(this->_sockfd, buffer, available, 0);
+        if (received <= 0) {
+            throw omnetpp::cRuntimeError(
+                    "Could not receive command string from protocol");
+        }
+        this->_rxBuffer.commitWrite(received);
+    }
+    return command;
 }
 
 void TcpExternalProtocolModuleBase::recvFromProtocol(
         std::string &commandString) {
-    const size_t bufferSize = UINT16_MAX;
-    char buffer[bufferSize];
-    memset(buffer, '\0', bufferSize);
-    size_t commandStringLength = 0;
-    // receive length of the command string
-    recvBytes(this->_sockfd, 2, buffer);
-    // convert length from bytes to int
-    commandStringLength += ((buffer[0] & 0xFF) << 8);
-    commandStringLength += ((buffer[1] & 0xFF) << 0);
-    // receive actual command string
-    if (commandStringLength >= bufferSize) {
-        throw omnetpp::cRuntimeError("Command string to long for buffer");
-    }
-    // receive actual command string
-    memset(buffer, '\0', bufferSize);
-    recvBytes(this->_sockfd, commandStringLength, buffer);
-    commandString = std::string(buffer);
+    size_t commandStringLength;
+    char *command = this->recvCommandFromProtocol(commandStringLength);
+    commandString.assign(command, commandStringLength);
 }
 
 }  // namespace estnet
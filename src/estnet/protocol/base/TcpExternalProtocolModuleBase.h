@@ -20,6 +20,7 @@
 #define __PROTOCOLS__TCP_EXTERNAL_PROTOCOL_MODULE_BASE_H__
 
 #include "ExternalProtocolModuleBase.h"
+#include "estnet/common/FrameReceiveBuffer.h"
 
 namespace estnet {
 
@@ -40,8 +41,12 @@ protected:
     virtual void sendToProtocol(const std::string &commandString) override;
     /** @brief receives a byte string from the socket */
     virtual void recvFromProtocol(std::string &commandString) override;
+    /** @brief receives a command from the socket into the receive buffer */
+    virtual char* recvCommandFromProtocol(size_t &length) override;
 private:
-    int _sockfd;
+    int _sockfd = -1;
+    // kept for the whole connection, a read may return several commands
+    FrameReceiveBuffer _rxBuffer;
 };
 
 }  // namespace estnet
@@ -19,6 +19,9 @@
 #ifndef __UTILS_SOCKET_UTILS_H__
 #define __UTILS_SOCKET_UTILS_H__
 
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
 #include <stdexcept>
 #include <sys/types.h>
 #ifdef __linux
@@ -37,8 +40,15 @@
 
 namespace estnet {
 
+/** flags for send, a peer that closed the connection must not raise SIGPIPE */
+#ifdef MSG_NOSIGNAL
+static const int SOCKET_SEND_FLAGS = MSG_NOSIGNAL;
+#else
+static const int SOCKET_SEND_FLAGS = 0;
+#endif
+
 /** @brief opens a TCP client socket */
-int open_tcp_client_socket(const char *host, unsigned short port) {
+inline int open_tcp_client_socket(const char *host, unsigned short port) {
     int sockfd = -1;
     // make port a string
     char port_str[6];
@@ -109,7 +119,7 @@ int open_tcp_client_socket(const char *host, unsigned short port) {
 }
 
 /** @brief sends given bytes over the given socket  */
-int sendBytes(int sockfd, size_t numBytes, const char *bytes) {
+inline int sendBytes(int sockfd, size_t numBytes, const char *bytes) {
     size_t sentBytes = 0;
     while (sentBytes < numBytes) {
         ssize_t sent = send(sockfd, bytes + sentBytes, numBytes - sentBytes, 0);
@@ -123,7 +133,7 @@ int sendBytes(int sockfd, size_t numBytes, const char *bytes) {
 }
 
 /** @brief receives numBytes from the given socket, memory must already be allocated */
-int recvBytes(int sockfd, size_t numBytes, char *bytes) {
+inline int recvBytes(int sockfd, size_t numBytes, char *bytes) {
     size_t recvdBytes = 0;
     while (recvdBytes < numBytes) {
         ssize_t recvd = recv(sockfd, bytes + recvdBytes, numBytes - recvdBytes,
@@ -138,7 +148,7 @@ int recvBytes(int sockfd, size_t numBytes, char *bytes) {
 }
 
 /** @brief checks if the given socket has data to receive */
-int checkIfDataAvailable(int sockfd) {
+inline int checkIfDataAvailable(int sockfd) {
     fd_set sockset;
     FD_ZERO(&sockset);
     FD_SET(sockfd, &sockset);
@@ -154,8 +164,68 @@ int checkIfDataAvailable(int sockfd) {
     return 0;
 }
 
+/**
+ * @brief opens a TCP server socket listening on all interfaces, port 0
+ * lets the system choose a free port, see get_socket_port
+ */
+inline int open_tcp_server_socket(unsigned short port) {
+    int sockfd = socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+    if (sockfd < 0) {
+        fprintf(stderr, "ERROR opening socket %d\n", sockfd);
+        return sockfd;
+    }
+    int so_reuseaddr_val = 1;
+    setsockopt(sockfd, SOL_SOCKET, SO_REUSEADDR,
+            (const char*) &so_reuseaddr_val, sizeof(int));
+    struct sockaddr_in addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_ANY);
+    addr.sin_port = htons(port);
+    if (bind(sockfd, (struct sockaddr*) &addr, sizeof(addr)) < 0
+            || listen(sockfd, 4) < 0) {
+        fprintf(stderr, "ERROR binding socket to port %d\n", port);
+        close(sockfd);
+        return -1;
+    }
+    return sockfd;
+}
+
+/** @brief returns the local port the given socket is bound to, -1 on error */
+inline int get_socket_port(int sockfd) {
+    struct sockaddr_in addr;
+    socklen_t length = sizeof(addr);
+    if (getsockname(sockfd, (struct sockaddr*) &addr, &length) < 0) {
+        return -1;
+    }
+    return ntohs(addr.sin_port);
+}
+
+/** @brief switches the given socket to non-blocking mode */
+inline int set_socket_nonblocking(int sockfd) {
+#ifdef __linux
+    int flags = fcntl(sockfd, F_GETFL, 0);
+    if (flags < 0) {
+        return flags;
+    }
+    return fcntl(sockfd, F_SETFL, flags | O_NONBLOCK);
+#else
+    u_long mode = 1;
+    return ioctlsocket(sockfd, FIONBIO, &mode);
+#endif
+}
+
+/** @brief checks whether the last socket operation failed only because it would block */
+inline bool socket_would_block() {
+#ifdef __linux
+    return errno == EAGAIN || errno == EWOULDBLOCK;
+#else
+    return WSAGetLastError() == WSAEWOULDBLOCK;
+#endif
+}
+
 /** @brief closes the given socket */
-void close_socket(int sockfd) {
+inline void close_socket(int sockfd) {
     if (sockfd > 0) {
         close(sockfd);
     }
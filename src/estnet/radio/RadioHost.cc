@@ -18,6 +18,10 @@
 
 #include "RadioHost.h"
 
+#include <algorithm>
+#include <cstring>
+#include <limits>
+
 #include <inet/linklayer/common/MacAddressTag_m.h>
 #include <inet/common/ProtocolTag_m.h>
 #include <inet/linklayer/common/MacAddressTag_m.h>
@@ -33,6 +37,19 @@ namespace estnet {
 
 Define_Module(RadioHost)
 
+// queued packets are handed to the radio after all other events at the same
+// time, so the MAC is done with the previous packet
+static const short TRANSMIT_QUEUE_PRIORITY = std::numeric_limits<short>::max();
+
+RadioHost::~RadioHost() {
+    for (auto &queue : this->_transmitQueues) {
+        this->cancelAndDelete(queue.timer);
+        for (auto &entry : queue.packets) {
+            delete entry.second;
+        }
+    }
+}
+
 int RadioHost::numInitStages() const {
     return 3;
 }
@@ -43,38 +60,124 @@ void RadioHost::initialize(int stage) {
         this->_nodeNo = this->par("nodeNo");
         this->_interPacketDelay = inet::units::values::s(par("interPacketDelay").doubleValueInUnit("s"));
 
-        _lastSendTime = -1;
-        _msgSameTime = 0;
+        this->_transmitQueues.resize(this->gateSize("lowerLayerOut"));
+        for (size_t i = 0; i < this->_transmitQueues.size(); i++) {
+            omnetpp::cMessage *timer = new omnetpp::cMessage("transmitQueue",
+                    i);
+            timer->setSchedulingPriority(TRANSMIT_QUEUE_PRIORITY);
+            this->_transmitQueues[i].timer = timer;
+        }
 
+        // nodes, radios and their connections may change anywhere in the
+        // network
+        this->getSimulation()->getSystemModule()->subscribe(
+                omnetpp::POST_MODEL_CHANGE, this);
     } else if (stage == 2) {
-        this->_gs = this->_nodeRegistry->getGroundStation(this->_nodeNo);
-
-        // find all connected radios
-        for (int i = 0; i < this->gateSize("lowerLayerOut"); i++) {
-            omnetpp::cGate *startGate = this->gate("lowerLayerOut", i);
-            if (startGate->getNextGate()->getOwnerModule()->hasGate(
-                    "lowerLayerOut")) {
-                startGate = startGate->getNextGate()->getOwnerModule()->gate(
-                        "lowerLayerOut");
-            }
-            for (omnetpp::cGate *gate = startGate->getNextGate(); gate; gate =
-                    gate->getNextGate()) {
-                cModule *nic = findContainingNicModule(gate->getOwnerModule());
-                if (nic != nullptr) {
-                    inet::physicallayer::IRadio *radio =
-                            omnetpp::check_and_cast<inet::physicallayer::IRadio*>(
-                                    nic->getSubmodule("radio"));
-                    this->_connectedRadios.emplace(i, radio);
-                    // found nic, we can stop walking along the gates
-                    break;
-                }
+        this->updateDestinations();
+    }
+}
+
+void RadioHost::finish() {
+    this->getSimulation()->getSystemModule()->unsubscribe(
+            omnetpp::POST_MODEL_CHANGE, this);
+}
+
+void RadioHost::receiveSignal(omnetpp::cComponent *source,
+        omnetpp::simsignal_t signal, omnetpp::cObject *obj,
+        omnetpp::cObject *details) {
+    if (signal != omnetpp::POST_MODEL_CHANGE) {
+        return;
+    }
+    // only changes of the nodes, the radio connections and the parameters
+    // the table is built from make it outdated, e.g. not display strings
+    if (dynamic_cast<omnetpp::cPostModuleAddNotification*>(obj)
+            || dynamic_cast<omnetpp::cPostModuleDeleteNotification*>(obj)
+            || dynamic_cast<omnetpp::cPostGateConnectNotification*>(obj)
+            || dynamic_cast<omnetpp::cPostGateDisconnectNotification*>(obj)) {
+        this->_destinationsValid = false;
+    } else if (auto change =
+            dynamic_cast<omnetpp::cPostParameterChangeNotification*>(obj)) {
+        const char *name = change->par->getName();
+        if (strcmp(name, "nodeNo") == 0
+                || strcmp(name, "internetConnection") == 0) {
+            this->_destinationsValid = false;
+        }
+    }
+}
+
+void RadioHost::updateDestinations() {
+    this->_gs = this->_nodeRegistry->getGroundStation(this->_nodeNo);
+
+    // find all connected radios
+    this->_connectedRadios.clear();
+    for (int i = 0; i < this->gateSize("lowerLayerOut"); i++) {
+        omnetpp::cGate *startGate = this->gate("lowerLayerOut", i);
+        if (startGate->getNextGate()->getOwnerModule()->hasGate(
+                "lowerLayerOut")) {
+            startGate = startGate->getNextGate()->getOwnerModule()->gate(
+                    "lowerLayerOut");
+        }
+        for (omnetpp::cGate *gate = startGate->getNextGate(); gate; gate =
+                gate->getNextGate()) {
+            cModule *nic = findContainingNicModule(gate->getOwnerModule());
+            if (nic != nullptr) {
+                inet::physicallayer::IRadio *radio =
+                        omnetpp::check_and_cast<inet::physicallayer::IRadio*>(
+                                nic->getSubmodule("radio"));
+                this->_connectedRadios.emplace(i, radio);
+                // found nic, we can stop walking along the gates
+                break;
             }
         }
     }
+
+    // index all nodes by their node no
+    this->_destinations.clear();
+    for (NodeBase *node : this->_nodeRegistry->getNodes()) {
+        unsigned int nodeNo = node->getNodeNo();
+        if (nodeNo >= this->_destinations.size()) {
+            this->_destinations.resize(nodeNo + 1);
+        }
+        Destination &destination = this->_destinations[nodeNo];
+        destination.node = node;
+        destination.mobility = node->getMobility();
+        destination.macAddress = getMacAddressOfNode(nodeNo, 1);
+    }
+    this->_groundStationRadioHosts.clear();
+    for (GroundStation *otherGs : this->_nodeRegistry->getGroundStations()) {
+        unsigned int otherNodeNo = otherGs->getNodeNo();
+        omnetpp::cModule *radioHost =
+                otherGs->getSubmodule("networkHost")->getSubmodule(
+                        "radioHost");
+        if (this->_nodeNo != otherNodeNo) {
+            this->_groundStationRadioHosts.push_back(radioHost);
+        }
+        if (this->_gs != nullptr
+                && this->_gs->canCommunicateWithoutRadioWith(otherNodeNo)) {
+            Destination &destination = this->_destinations[otherNodeNo];
+            destination.groundStation = otherGs;
+            destination.radioHost = radioHost;
+        }
+    }
+    this->_destinationsValid = true;
+}
+
+const RadioHost::Destination* RadioHost::getDestination(
+        unsigned int destNodeId) {
+    if (!this->_destinationsValid) {
+        this->updateDestinations();
+    }
+    if (destNodeId >= this->_destinations.size()
+            || this->_destinations[destNodeId].node == nullptr) {
+        return nullptr;
+    }
+    return &this->_destinations[destNodeId];
 }
 
 void RadioHost::handleMessage(omnetpp::cMessage *msg) {
-    if (msg->arrivedOn("upperLayerIn")) {
+    if (msg->isSelfMessage()) {
+        this->processTransmitQueue(msg->getKind());
+    } else if (msg->arrivedOn("upperLayerIn")) {
         // message from the upper layer
         // we'll have to decide if we use the radio or send it directly to the
         // ground station node
@@ -89,25 +192,16 @@ void RadioHost::handleMessage(omnetpp::cMessage *msg) {
         if (broadcast) {
             macAddressReq->setDestAddress(inet::MacAddress::BROADCAST_ADDRESS);
         } else {
-            macAddressReq->setDestAddress(getMacAddressOfNode(destNodeId, 1));
+            const Destination *destination = this->getDestination(destNodeId);
+            macAddressReq->setDestAddress(
+                    destination != nullptr ?
+                            destination->macAddress :
+                            getMacAddressOfNode(destNodeId, 1));
         }
         macAddressReq->setSrcAddress(getMacAddressOfNode(this->_nodeNo, 1));
 
         GroundStation *destinationCGS = this->isForGroundStation(destNodeId);
 
-        // FIXME: As of inet 4.2 the acking mac module can not handle two or more
-        // packages scheduled at exactly the same time. So the following packets
-        // scheduled at exactly the same time are delayed. The delays are chosen
-        // to account for the internal delay of the mac module. It should not effect
-        // the simulation results, since the time delay is small compared to a usual
-        // transmission duration.
-        if (fabs(_lastSendTime - omnetpp::simTime()) <= 2e-6) {
-            _msgSameTime = 1;
-        } else {
-            _msgSameTime = 0;
-            _lastSendTime = omnetpp::simTime();
-        }
-
         if (destinationCGS != nullptr) {
             // packet is for one specific ground station
             EV_DEBUG << "Sending frame '" << pkt->getName()
@@ -120,24 +214,24 @@ void RadioHost::handleMessage(omnetpp::cMessage *msg) {
             int radioGateIdx = this->chooseRadio(destNodeId);
             EV_DEBUG << "Sending frame '" << pkt->getName() << "' to radio "
                             << radioGateIdx << omnetpp::endl;
-            this->sendDirect(pkt, _msgSameTime * 2e-6, 0, this, "lowerLayerOut",
-                    radioGateIdx);
+            this->sendToRadio(pkt, radioGateIdx, 0);
         } else if (broadcast) {
             EV_DEBUG << "Broadcasting frame '" << pkt->getName()
                             << "' to all connected ground stations and radios"
                             << omnetpp::endl;
             // is a broadcast, first sent to all other ground stations
-            for (const auto &otherGs : this->_nodeRegistry->getGroundStations()) {
-                if (this->_nodeNo != otherGs->getNodeNo())
-                    this->sendToGroundStation(otherGs, pkt->dup());
+            if (!this->_destinationsValid) {
+                this->updateDestinations();
+            }
+            for (omnetpp::cModule *radioHost : this->_groundStationRadioHosts) {
+                this->sendDirect(pkt->dup(), radioHost, "forwardToUpperLayer");
             }
             // then send to all radios
             const int numLowerLayerOut = this->gateSize("lowerLayerOut");
             const double interTxDelay = (numLowerLayerOut > 1) ? _interPacketDelay.get() : 0.0;
             for (int i = 0; i < numLowerLayerOut; i++) {
                 // using a small delay, so broadcasts don't interfer with each when nodes are moving
-                this->sendDirect(pkt->dup(), interTxDelay + _msgSameTime * 2e-6,
-                        0, this, "lowerLayerOut", i);
+                this->sendToRadio(pkt->dup(), i, interTxDelay);
             }
             // delete original packet since we duplicated it
             delete pkt;
@@ -150,39 +244,89 @@ void RadioHost::handleMessage(omnetpp::cMessage *msg) {
     }
 }
 
+void RadioHost::sendToRadio(inet::Packet *pkt, int radioGateIdx,
+        omnetpp::simtime_t delay) {
+    // As of inet 4.2 the acking mac module can not handle two or more
+    // packets arriving at exactly the same time, so these are queued and
+    // handed over one by one
+    TransmitQueue &queue = this->_transmitQueues.at(radioGateIdx);
+    omnetpp::simtime_t sendTime = omnetpp::simTime() + delay;
+    if (delay == 0 && queue.packets.empty()
+            && queue.lastSendTime != sendTime) {
+        queue.lastSendTime = sendTime;
+        this->sendDirect(pkt, this, "lowerLayerOut", radioGateIdx);
+        return;
+    }
+    queue.packets.emplace(sendTime, pkt);
+    omnetpp::simtime_t nextSendTime = queue.packets.begin()->first;
+    if (!queue.timer->isScheduled()
+            || queue.timer->getArrivalTime() > nextSendTime) {
+        this->cancelEvent(queue.timer);
+        this->scheduleAt(nextSendTime, queue.timer);
+    }
+}
+
+void RadioHost::processTransmitQueue(int radioGateIdx) {
+    TransmitQueue &queue = this->_transmitQueues.at(radioGateIdx);
+    if (queue.packets.empty()) {
+        return;
+    }
+    auto first = queue.packets.begin();
+    inet::Packet *pkt = first->second;
+    queue.packets.erase(first);
+    queue.lastSendTime = omnetpp::simTime();
+    EV_DEBUG << "Handing queued frame '" << pkt->getName() << "' to radio "
+                    << radioGateIdx << omnetpp::endl;
+    this->sendDirect(pkt, this, "lowerLayerOut", radioGateIdx);
+    if (!queue.packets.empty()) {
+        this->scheduleAt(
+                std::max(queue.packets.begin()->first, omnetpp::simTime()),
+                queue.timer);
+    }
+}
+
 bool RadioHost::isBroadcast(const inet::MacAddress &macAddress) {
     return macAddress == inet::MacAddress::BROADCAST_ADDRESS;
 }
 
 GroundStation* RadioHost::isForGroundStation(unsigned int destNodeId) {
-    GroundStation *otherGs = this->_nodeRegistry->getGroundStation(destNodeId);
+    // the table only holds ground stations connected to this one
+    const Destination *destination = this->getDestination(destNodeId);
+    GroundStation *otherGs =
+            destination != nullptr ? destination->groundStation : nullptr;
     EV_TRACE << "RadioHost::isForGroundStation(" << destNodeId << ") thisGs"
-                    << (this->_gs != nullptr) << ", otherGs "
+                    << (this->_gs != nullptr) << ", connectedGs "
                     << (otherGs != nullptr) << "" << omnetpp::endl;
-    if (this->_gs != nullptr && otherGs != nullptr
-            && this->_gs->canCommunicateWithoutRadioWith(destNodeId)) {
-        return otherGs;
-    } else {
-        return nullptr;
-    }
+    return otherGs;
 }
 
 void RadioHost::sendToGroundStation(GroundStation *otherGs, inet::Packet *pkt) {
-    this->sendDirect(pkt,
-            otherGs->getSubmodule("networkHost")->getSubmodule("radioHost"),
-            "forwardToUpperLayer");
+    const Destination *destination = this->getDestination(otherGs->getNodeNo());
+    omnetpp::cModule *radioHost =
+            destination != nullptr && destination->radioHost != nullptr ?
+                    destination->radioHost :
+                    otherGs->getSubmodule("networkHost")->getSubmodule(
+                            "radioHost");
+    this->sendDirect(pkt, radioHost, "forwardToUpperLayer");
 }
 
 int RadioHost::chooseRadio(unsigned int destNodeId) {
+    if (!this->_destinationsValid) {
+        this->updateDestinations();
+    }
     // get access to target node and its position
     int bestGateIdx = -1;
     double bestGateMetric = std::numeric_limits<double>::infinity();
-    NodeBase *destinationNode = this->_nodeRegistry->getNode(destNodeId);
-    inet::IMobility *destMobility = destinationNode->getMobility();
-    inet::Coord destPosition = destMobility->getCurrentPosition();
 
     // if the node has multiple radios find the one with smallest antenna pointing error
     if (this->_connectedRadios.size() > 1) {
+        const Destination *destination = this->getDestination(destNodeId);
+        if (destination == nullptr) {
+            throw omnetpp::cRuntimeError("Unknown destination node %u",
+                    destNodeId);
+        }
+        inet::Coord destPosition =
+                destination->mobility->getCurrentPosition();
         for (const auto &connectedRadioEntry : this->_connectedRadios) {
             int currentGateIdx = connectedRadioEntry.first;
             inet::physicallayer::IRadio *currentRadio =
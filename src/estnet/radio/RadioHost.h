@@ -20,10 +20,13 @@
 #define __RADIOS_RADIO_HOST_H__
 
 #include <map>
+#include <vector>
 
 #include <omnetpp.h>
 #include <inet/common/geometry/common/Coord.h>
+#include <inet/common/packet/Packet.h>
 #include <inet/linklayer/common/MacAddress.h>
+#include <inet/mobility/contract/IMobility.h>
 #include <inet/physicallayer/contract/packetlevel/IRadio.h>
 #include <inet/queueing/contract/IPacketQueue.h>
 
@@ -35,15 +38,66 @@ namespace estnet {
 /**
  * Decides which radio a packet needs to be sent with.
  * Deduplicates received packets over multiple radios.
+ * The MAC addresses, mobilities and ground station connections of all
+ * destination nodes are kept in a table indexed by node no, which is
+ * rebuilt after changes of the model. Packets for a radio that already
+ * got a packet at the current simulation time are queued and handed to
+ * the radio after the events of the MAC at that time.
  */
-class ESTNET_API RadioHost: public omnetpp::cSimpleModule {
+class ESTNET_API RadioHost: public omnetpp::cSimpleModule,
+        public omnetpp::cListener {
 protected:
+    /**
+     * Everything needed to send a packet to a node
+     */
+    struct Destination {
+        NodeBase *node = nullptr;
+        inet::IMobility *mobility = nullptr;
+        /** @brief set if the node is a ground station reachable without radio */
+        GroundStation *groundStation = nullptr;
+        /** @brief radio host of the node, if it is a ground station */
+        omnetpp::cModule *radioHost = nullptr;
+        inet::MacAddress macAddress;
+    };
+
+    /**
+     * Packets waiting to be handed to one radio, ordered by their send time
+     */
+    struct TransmitQueue {
+        std::multimap<omnetpp::simtime_t, inet::Packet*> packets;
+        omnetpp::cMessage *timer = nullptr;
+        omnetpp::simtime_t lastSendTime = -1;
+    };
+
+    /** @brief cleanup */
+    virtual ~RadioHost();
+
     /** @brief returns number of initalization stages */
     virtual int numInitStages() const override;
     /** @brief initialization */
     virtual void initialize(int stage) override;
     /** @brief message receiver function */
     virtual void handleMessage(omnetpp::cMessage*) override;
+    /** @brief unsubscribes from model changes */
+    virtual void finish() override;
+    /** @brief marks the destination table outdated when nodes, radio
+     *  connections or the parameters of the table change */
+    virtual void receiveSignal(omnetpp::cComponent *source,
+            omnetpp::simsignal_t signal, omnetpp::cObject *obj,
+            omnetpp::cObject *details) override;
+
+    /** @brief rebuilds the connected radios and the destination table */
+    virtual void updateDestinations();
+    /** @brief returns the table entry for the node no or null */
+    const Destination* getDestination(unsigned int destNodeId);
+    /**
+     * @brief hands the packet to the radio behind the gate index after the
+     * delay, queues it if the radio already got a packet at that time
+     */
+    virtual void sendToRadio(inet::Packet *pkt, int radioGateIdx,
+            omnetpp::simtime_t delay);
+    /** @brief sends the next queued packet of the radio */
+    virtual void processTransmitQueue(int radioGateIdx);
 
     /** @brief checks whether mac address indicates a broadcast */
     virtual bool isBroadcast(const inet::MacAddress &macAddress);
@@ -57,10 +111,15 @@ private:
     NodeRegistry *_nodeRegistry;
     unsigned int _nodeNo;
     GroundStation *_gs;
-    simtime_t _lastSendTime;
-    int _msgSameTime;
     inet::units::values::s _interPacketDelay;
     std::map<int, inet::physicallayer::IRadio*> _connectedRadios;
+    // indexed by node no, valid until the next model change
+    std::vector<Destination> _destinations;
+    bool _destinationsValid = false;
+    // radio hosts of all other ground stations, broadcasts are sent to them
+    std::vector<omnetpp::cModule*> _groundStationRadioHosts;
+    // indexed by the lowerLayerOut gate index
+    std::vector<TransmitQueue> _transmitQueues;
     std::set<std::tuple<unsigned int, long, int64_t>> _seenFrames;
 };
 
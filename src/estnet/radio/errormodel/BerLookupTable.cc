@@ -0,0 +1,95 @@
+//
+// Copyright (C) 2020 Computer Science VII: Robotics and Telematics - 
+// Julius-Maximilians-Universitaet Wuerzburg
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see http://www.gnu.org/licenses/.
+//
+
+
+#include "BerLookupTable.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace estnet {
+
+// error rates below are treated as 0, their logarithm is still finite
+static const double MIN_ERROR_RATE = 1e-300;
+
+BerLookupTable::BerLookupTable(std::function<double(double)> errorRate,
+        int minExponent, int maxExponent, int stepsPerOctave) :
+        _errorRate(errorRate), _minExponent(minExponent), _stepsPerOctave(
+                stepsPerOctave) {
+    this->_minRatio = std::ldexp(0.5, minExponent);
+    this->_maxRatio = std::ldexp(0.5, maxExponent);
+    this->_zeroRatio = std::numeric_limits<double>::infinity();
+
+    size_t numSamples = (maxExponent - minExponent) * stepsPerOctave + 1;
+    this->_logErrorRates.resize(numSamples);
+    for (size_t i = 0; i < numSamples; i++) {
+        double ratio = this->getRatio(i);
+        double rate = errorRate(ratio);
+        if (rate < MIN_ERROR_RATE && ratio < this->_zeroRatio) {
+            // the function is used between the last sample above and this one
+            this->_zeroRatio = ratio;
+            this->_maxRatio = i > 0 ? this->getRatio(i - 1) : this->_minRatio;
+        }
+        this->_logErrorRates[i] = std::log(std::max(rate, MIN_ERROR_RATE));
+    }
+
+    // measure the interpolation error where it is largest, between samples
+    for (size_t i = 0; i + 1 < numSamples; i++) {
+        double ratio = (this->getRatio(i) + this->getRatio(i + 1)) / 2;
+        if (ratio >= this->_maxRatio) {
+            break;
+        }
+        double exact = errorRate(ratio);
+        double relativeError = std::abs(this->lookup(ratio) - exact) / exact;
+        this->_maxRelativeError = std::max(this->_maxRelativeError,
+                relativeError);
+    }
+}
+
+double BerLookupTable::getRatio(size_t index) const {
+    int octave = index / this->_stepsPerOctave;
+    int step = index % this->_stepsPerOctave;
+    return std::ldexp(0.5 + 0.5 * step / this->_stepsPerOctave,
+            this->_minExponent + octave);
+}
+
+double BerLookupTable::lookup(double ratio) const {
+    if (ratio >= this->_zeroRatio) {
+        return 0;
+    }
+    if (!(ratio >= this->_minRatio && ratio < this->_maxRatio)) {
+        // outside of the table (or NaN)
+        return this->_errorRate(ratio);
+    }
+    // ratio = mantissa * 2^exponent with mantissa in [0.5, 1)
+    int exponent;
+    double mantissa = std::frexp(ratio, &exponent);
+    double position = (mantissa - 0.5) * 2 * this->_stepsPerOctave;
+    int step = (int) position;
+    double weight = position - step;
+    size_t index = (exponent - this->_minExponent) * this->_stepsPerOctave
+            + step;
+    double logErrorRate = this->_logErrorRates[index]
+            + weight
+                    * (this->_logErrorRates[index + 1]
+                            - this->_logErrorRates[index]);
+    return std::exp(logErrorRate);
+}
+
+}  // namespace estnet
@@ -0,0 +1,91 @@
+//
+// Copyright (C) 2020 Computer Science VII: Robotics and Telematics - 
+// Julius-Maximilians-Universitaet Wuerzburg
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see http://www.gnu.org/licenses/.
+//
+
+
+#ifndef __UTILS__BER_LOOKUP_TABLE_H__
+#define __UTILS__BER_LOOKUP_TABLE_H__
+
+#include <functional>
+#include <vector>
+
+#include "estnet/common/ESTNETDefs.h"
+
+namespace estnet {
+
+/**
+ * Precomputed table of a monotonically decreasing error rate function,
+ * e.g. a BER as a function of Eb/N0 or SNIR (as ratio, not dB).
+ * The table is sampled densely and geometrically: every octave of the
+ * ratio is divided into the same number of equal steps. A lookup finds the
+ * step with frexp and interpolates the logarithm of the error rate linearly,
+ * which follows the exponential decay of erfc-based rates closely.
+ * The largest relative error at the step midpoints is measured when the table
+ * is built (~getMaxRelativeError), for erfc-based rates and the default
+ * resolution it is below 1e-5.
+ * Ratios below the table use the function itself, error rates below 1e-300
+ * are returned as 0.
+ */
+class ESTNET_API BerLookupTable {
+public:
+    /**
+     * Samples the function
+     * @param errorRate: error rate as function of the ratio
+     * @param minExponent: table starts at ratio 2^(minExponent-1)
+     * @param maxExponent: table ends at ratio 2^(maxExponent-1)
+     * @param stepsPerOctave: resolution of the table
+     */
+    BerLookupTable(std::function<double(double)> errorRate,
+            int minExponent = -9, int maxExponent = 15,
+            int stepsPerOctave = 128);
+
+    /** @brief returns the interpolated error rate for the ratio */
+    double lookup(double ratio) const;
+    /** @brief returns the error rate of the sampled function */
+    double evaluate(double ratio) const {
+        return this->_errorRate(ratio);
+    }
+
+    /** @brief largest relative error between lookup and function found at
+     *  the step midpoints */
+    double getMaxRelativeError() const {
+        return this->_maxRelativeError;
+    }
+    /** @brief number of samples in the table */
+    size_t getNumSamples() const {
+        return this->_logErrorRates.size();
+    }
+
+private:
+    /** @brief returns the ratio of the sample with the index */
+    double getRatio(size_t index) const;
+
+    std::function<double(double)> _errorRate;
+    int _minExponent;
+    int _stepsPerOctave;
+    double _minRatio;
+    double _maxRatio;
+    // error rates at and above this ratio are smaller than 1e-300
+    double _zeroRatio;
+    // natural logarithm of the error rate at each sample
+    std::vector<double> _logErrorRates;
+    double _maxRelativeError = 0;
+};
+
+}  // namespace estnet
+
+#endif
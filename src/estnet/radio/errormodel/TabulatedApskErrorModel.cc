@@ -0,0 +1,69 @@
+//
+// Copyright (C) 2020 Computer Science VII: Robotics and Telematics - 
+// Julius-Maximilians-Universitaet Wuerzburg
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see http://www.gnu.org/licenses/.
+//
+
+
+#include "TabulatedApskErrorModel.h"
+
+#include <inet/physicallayer/base/packetlevel/FlatTransmissionBase.h>
+
+#include "estnet/radio/gmsk/GMSKModulation.h"
+#include "estnet/radio/psk8/PSK8Modulation.h"
+
+namespace estnet {
+
+Define_Module(TabulatedApskErrorModel);
+
+std::ostream& TabulatedApskErrorModel::printToStream(std::ostream &stream,
+        int level) const {
+    return stream << "TabulatedApskErrorModel";
+}
+
+double TabulatedApskErrorModel::computeBitErrorRate(
+        const inet::physicallayer::ISnir *snir,
+        inet::physicallayer::IRadioSignal::SignalPart part) const {
+    Enter_Method_Silent();
+    auto flatTransmission = omnetpp::check_and_cast<
+            const inet::physicallayer::FlatTransmissionBase*>(
+            snir->getReception()->getTransmission());
+    auto modulation = omnetpp::check_and_cast<
+            const inet::physicallayer::IApskModulation*>(
+            flatTransmission->getModulation());
+    inet::Hz bandwidth = flatTransmission->getBandwidth();
+    inet::bps bitrate = flatTransmission->getBitrate();
+
+    // the transmitter may already use a tabulated modulation, which must
+    // not be interpolated a second time
+    auto gmsk = dynamic_cast<const GMSKModulation*>(modulation);
+    auto psk8 = dynamic_cast<const PSK8Modulation*>(modulation);
+    if ((gmsk != nullptr && gmsk->usesLookupTable())
+            || (psk8 != nullptr && psk8->usesLookupTable())) {
+        return modulation->calculateBER(this->getScalarSnir(snir), bandwidth,
+                bitrate);
+    }
+
+    auto &table = this->_tables[TableKey(modulation, bandwidth.get(),
+            bitrate.get())];
+    if (!table) {
+        table.reset(new BerLookupTable([=](double ratio) {
+            return modulation->calculateBER(ratio, bandwidth, bitrate);
+        }));
+    }
+    return table->lookup(this->getScalarSnir(snir));
+}
+
+}  // namespace estnet
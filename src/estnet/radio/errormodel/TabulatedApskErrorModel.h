@@ -0,0 +1,63 @@
+//
+// Copyright (C) 2020 Computer Science VII: Robotics and Telematics - 
+// Julius-Maximilians-Universitaet Wuerzburg
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see http://www.gnu.org/licenses/.
+//
+
+
+#ifndef __UTILS__TABULATED_APSK_ERROR_MODEL_H__
+#define __UTILS__TABULATED_APSK_ERROR_MODEL_H__
+
+#include <map>
+#include <memory>
+#include <tuple>
+
+#include <inet/physicallayer/contract/packetlevel/IApskModulation.h>
+#include <inet/physicallayer/errormodel/packetlevel/ApskErrorModel.h>
+
+#include "estnet/common/ESTNETDefs.h"
+#include "BerLookupTable.h"
+
+namespace estnet {
+
+/**
+ * ~ApskErrorModel that takes the BER from a ~BerLookupTable instead of
+ * calling the modulation's BER function for every reception. A table is
+ * built on first use for every combination of modulation, bandwidth and
+ * bitrate. Transmissions whose GMSK or 8PSK modulation already uses a
+ * table are evaluated by the modulation directly.
+ */
+class ESTNET_API TabulatedApskErrorModel: public inet::physicallayer::ApskErrorModel {
+private:
+    typedef std::tuple<const inet::physicallayer::IApskModulation*, double,
+            double> TableKey;
+    mutable std::map<TableKey, std::unique_ptr<BerLookupTable>> _tables;
+
+public:
+    /** @brief Prints this object to the provided output stream */
+    virtual std::ostream& printToStream(std::ostream &stream, int level) const
+            override;
+
+    /**
+     * Returns the bit error rate based on SNIR, modulation, FEC encoding
+     * and any other physical layer characteristics.
+     */
+    virtual double computeBitErrorRate(const inet::physicallayer::ISnir *snir,
+            inet::physicallayer::IRadioSignal::SignalPart part) const override;
+};
+
+}  // namespace estnet
+
+#endif
@@ -32,7 +32,7 @@ void APSKScalarTransmitterWithGMSK::initialize(int stage) {
         if (par("modulation").stdstringValue() != "GMSK") {
             throw omnetpp::cRuntimeError("Only GMSK modulation is supported");
         }
-        modulation = new GMSKModulation();
+        modulation = new GMSKModulation(par("useBerLookupTable").boolValue());
         centerFrequency = inet::Hz(
                 par("centerFrequency").doubleValueInUnit("Hz"));
         bandwidth = inet::Hz(par("bandwidth").doubleValueInUnit("Hz"));
@@ -18,13 +18,27 @@
 
 #include "GMSKModulation.h"
 
+#include <cmath>
+
+#include "estnet/radio/errormodel/BerLookupTable.h"
+
 namespace estnet {
 
-double GMSKModulation::calculateBER(double snir, inet::Hz bandwidth,
-        inet::bps bitrate) const {
+double GMSKModulation::calculateBER(double ebN0) {
     //http://ijarcet.org/wp-content/uploads/IJARCET-VOL-2-ISSUE-4-1389-1392.pdf
     //https://www.unilim.fr/pages_perso/vahid/notes/ber_awgn.pdf
-    return (0.5 * erfc(sqrt(0.68 * snir * bandwidth.get() / bitrate.get())));
+    return (0.5 * erfc(sqrt(0.68 * ebN0)));
+}
+
+double GMSKModulation::calculateBER(double snir, inet::Hz bandwidth,
+        inet::bps bitrate) const {
+    if (this->_useLookupTable) {
+        // shared by all modulation instances, built on first use
+        static const BerLookupTable table(
+                static_cast<double (*)(double)>(&GMSKModulation::calculateBER));
+        return table.lookup(snir * bandwidth.get() / bitrate.get());
+    }
+    return calculateBER(snir * bandwidth.get() / bitrate.get());
 }
 
 double GMSKModulation::calculateSER(double snir, inet::Hz bandwidth,
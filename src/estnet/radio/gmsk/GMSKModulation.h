@@ -27,15 +27,28 @@ namespace estnet {
 
 /**
  * Implements BER & SER calculations for the GMSK modulation.
+ * The BER can be taken from a precomputed ~BerLookupTable instead of
+ * evaluating erfc for every call.
  */
 class ESTNET_API GMSKModulation: public inet::physicallayer::ApskModulationBase {
+private:
+    bool _useLookupTable;
 public:
-    GMSKModulation() :
+    GMSKModulation(bool useLookupTable = false) :
             inet::physicallayer::ApskModulationBase(
-                    new std::vector<inet::physicallayer::ApskSymbol>()) {
+                    new std::vector<inet::physicallayer::ApskSymbol>()), _useLookupTable(
+                    useLookupTable) {
     }
     ;
 
+    /** @brief BER as a function of Eb/N0, i.e. snir * bandwidth / bitrate */
+    static double calculateBER(double ebN0);
+
+    /** @brief whether the BER is taken from the precomputed table */
+    bool usesLookupTable() const {
+        return this->_useLookupTable;
+    }
+
     /** @brief Prints this object to the provided output stream */
     virtual std::ostream& printToStream(std::ostream &stream, int level) const
             override {
@@ -0,0 +1,337 @@
+//
+// Copyright (C) 2020 Computer Science VII: Robotics and Telematics - 
+// Julius-Maximilians-Universitaet Wuerzburg
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see http://www.gnu.org/licenses/.
+//
+
+
+#include "CullingRadioMedium.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <typeinfo>
+
+#include <inet/common/geometry/shape/Sphere.h>
+#include <inet/environment/contract/IPhysicalEnvironment.h>
+#include <inet/physicallayer/analogmodel/packetlevel/ScalarAnalogModel.h>
+#include <inet/physicallayer/analogmodel/packetlevel/ScalarNoise.h>
+#include <inet/physicallayer/common/packetlevel/BandListening.h>
+#include <inet/physicallayer/contract/packetlevel/IInterference.h>
+#include <inet/physicallayer/contract/packetlevel/IRadioSignal.h>
+#include <inet/physicallayer/obstacleloss/IdealObstacleLoss.h>
+
+#include "estnet/radio/errormodel/PerfectErrorModel.h"
+
+namespace estnet {
+
+Define_Module(CullingRadioMedium);
+
+void CullingRadioMedium::initialize(int stage) {
+    inet::physicallayer::RadioMedium::initialize(stage);
+    if (stage == inet::INITSTAGE_LOCAL) {
+        this->_receiverCulling = this->par("receiverCulling").boolValue();
+        this->_perfectReceptionShortcut = this->par("perfectReceptionShortcut").boolValue();
+        this->_perfectReceptionShortcutCheck = this->par("perfectReceptionShortcutCheck").boolValue();
+        this->_earthOcclusionRadius = this->par("earthOcclusionRadius").doubleValueInUnit("m");
+        this->_rangeMargin = this->par("cullingRangeMargin").doubleValue();
+        this->_positionUpdateInterval = this->par("positionUpdateInterval").doubleValueInUnit("s");
+        if (this->_rangeMargin < 0) {
+            throw omnetpp::cRuntimeError(
+                    "cullingRangeMargin must not be negative");
+        }
+    } else if (stage == inet::INITSTAGE_LAST) {
+        // only an ideal obstacle loss blocks the signals behind the Earth
+        // completely, other obstacle losses still let them interfere, and
+        // only if the Earth is one of the obstacles
+        this->_earthOcclusion = dynamic_cast<
+                const inet::physicallayer::IdealObstacleLoss*>(
+                this->obstacleLoss) != nullptr && this->hasEarthObstacle();
+    }
+}
+
+void CullingRadioMedium::finish() {
+    inet::physicallayer::RadioMedium::finish();
+    this->recordScalar("culled receiver count", this->_culledReceiverCount);
+}
+
+void CullingRadioMedium::addRadio(const inet::physicallayer::IRadio *radio) {
+    inet::physicallayer::RadioMedium::addRadio(radio);
+    this->invalidateCullingCache();
+}
+
+void CullingRadioMedium::removeRadio(
+        const inet::physicallayer::IRadio *radio) {
+    inet::physicallayer::RadioMedium::removeRadio(radio);
+    this->invalidateCullingCache();
+}
+
+void CullingRadioMedium::invalidateCullingCache() {
+    this->_positionTree.reset();
+    this->_interferenceRanges.clear();
+    this->_perfectErrorModels.clear();
+}
+
+void CullingRadioMedium::sendToAffectedRadios(
+        inet::physicallayer::IRadio *transmitter,
+        const inet::physicallayer::ISignal *signal) {
+    if (!this->_receiverCulling) {
+        inet::physicallayer::RadioMedium::sendToAffectedRadios(transmitter,
+                signal);
+        return;
+    }
+    const inet::physicallayer::ITransmission *transmission =
+            signal->getTransmission();
+    const inet::Coord transmitterPosition = transmission->getStartPosition();
+
+    // collect candidates in the order of the radios, so the signals are sent
+    // in the same order as without culling
+    std::vector<size_t> candidates;
+    double range = this->getInterferenceRange(transmitter);
+    if (std::isfinite(range)) {
+        this->updatePositionTree();
+        double age = (omnetpp::simTime() - this->_positionTreeTime).dbl();
+        double searchRadius = range + (age > 0 ? this->_maxSpeed * age : 0.0);
+        const double queryPoint[3] = { transmitterPosition.x,
+                transmitterPosition.y, transmitterPosition.z };
+        std::vector<std::pair<size_t, double>> matches;
+        nanoflann::SearchParams params;
+        params.sorted = false;
+        if (this->_positionCloud.kdtree_get_point_count() > 0) {
+            this->_positionTree->radiusSearch(queryPoint,
+                    searchRadius * searchRadius, matches, params);
+        }
+        candidates.reserve(matches.size());
+        for (const auto &match : matches) {
+            candidates.push_back(
+                    this->_positionCloud.radioIndices[match.first]);
+        }
+        std::sort(candidates.begin(), candidates.end());
+        this->_culledReceiverCount += this->_positionCloud.radioIndices.size()
+                - candidates.size();
+    } else {
+        for (size_t i = 0; i < this->radios.size(); i++) {
+            candidates.push_back(i);
+        }
+    }
+
+    for (size_t i : candidates) {
+        const inet::physicallayer::IRadio *receiver = this->radios[i];
+        if (receiver == nullptr || receiver == transmitter) {
+            continue;
+        }
+        const inet::Coord receiverPosition =
+                receiver->getAntenna()->getMobility()->getCurrentPosition();
+        if (transmitterPosition.distance(receiverPosition) > range
+                || (this->_earthOcclusion
+                        && this->isOccludedByEarth(transmitterPosition,
+                                receiverPosition))) {
+            this->_culledReceiverCount++;
+            continue;
+        }
+        this->sendToRadio(transmitter, receiver, signal);
+    }
+}
+
+void CullingRadioMedium::updatePositionTree() {
+    omnetpp::simtime_t now = omnetpp::simTime();
+    if (this->_positionTree != nullptr
+            && (now == this->_positionTreeTime
+                    || (std::isfinite(this->_maxSpeed)
+                            && now - this->_positionTreeTime
+                                    < this->_positionUpdateInterval))) {
+        return;
+    }
+    this->_positionCloud.positions.clear();
+    this->_positionCloud.radioIndices.clear();
+    this->_maxSpeed = 0;
+    for (size_t i = 0; i < this->radios.size(); i++) {
+        const inet::physicallayer::IRadio *radio = this->radios[i];
+        if (radio == nullptr) {
+            continue;
+        }
+        inet::IMobility *mobility = radio->getAntenna()->getMobility();
+        this->_positionCloud.positions.push_back(
+                mobility->getCurrentPosition());
+        this->_positionCloud.radioIndices.push_back(i);
+        // without a known maximum speed the tree is rebuilt whenever the
+        // simulation time advances
+        double maxSpeed = mobility->getMaxSpeed();
+        this->_maxSpeed =
+                maxSpeed >= 0 ?
+                        std::max(this->_maxSpeed, maxSpeed) :
+                        std::numeric_limits<double>::infinity();
+    }
+    this->_positionTree.reset(
+            new PositionTree(3, this->_positionCloud,
+                    nanoflann::KDTreeSingleIndexAdaptorParams(10)));
+    this->_positionTree->buildIndex();
+    this->_positionTreeTime = now;
+}
+
+double CullingRadioMedium::getInterferenceRange(
+        const inet::physicallayer::IRadio *transmitter) {
+    auto it = this->_interferenceRanges.find(transmitter->getId());
+    if (it != this->_interferenceRanges.end()) {
+        return it->second;
+    }
+    // the range INET's interference range filter uses, receivers beyond it
+    // neither decode nor sense the signal; the margin covers the movement
+    // during propagation
+    double range = this->mediumLimitCache->getMaxInterferenceRange(
+            transmitter).get();
+    range = std::isnan(range) ?
+            std::numeric_limits<double>::infinity() :
+            range * (1 + this->_rangeMargin);
+    this->_interferenceRanges.emplace(transmitter->getId(), range);
+    return range;
+}
+
+const inet::physicallayer::ISnir* CullingRadioMedium::getSNIR(
+        const inet::physicallayer::IRadio *receiver,
+        const inet::physicallayer::ITransmission *transmission) const {
+    if (!this->_perfectReceptionShortcut
+            || !this->hasPerfectErrorModel(receiver)) {
+        return inet::physicallayer::RadioMedium::getSNIR(receiver,
+                transmission);
+    }
+    const inet::physicallayer::ISnir *snir =
+            this->communicationCache->getCachedSNIR(receiver, transmission);
+    if (snir == nullptr) {
+        const inet::physicallayer::IListening *listening = this->getListening(
+                receiver, transmission);
+        snir = this->computeScalarSnir(
+                this->getReception(receiver, transmission), listening,
+                this->getInterference(receiver, listening, transmission));
+        if (snir == nullptr) {
+            return inet::physicallayer::RadioMedium::getSNIR(receiver,
+                    transmission);
+        }
+        if (this->_perfectReceptionShortcutCheck) {
+            this->checkScalarSnir(receiver, transmission, snir);
+        }
+        this->communicationCache->setCachedSNIR(receiver, transmission, snir);
+    }
+    return snir;
+}
+
+void CullingRadioMedium::checkScalarSnir(
+        const inet::physicallayer::IRadio *receiver,
+        const inet::physicallayer::ITransmission *transmission,
+        const inet::physicallayer::ISnir *snir) const {
+    // the full computation of RadioMedium::getSNIR, without caching
+    const inet::physicallayer::IListening *listening = this->getListening(
+            receiver, transmission);
+    const inet::physicallayer::INoise *noise = this->analogModel->computeNoise(
+            listening,
+            this->getInterference(receiver, listening, transmission));
+    const inet::physicallayer::ISnir *expected =
+            this->analogModel->computeSNIR(snir->getReception(), noise);
+    double expectedMin = expected->getMin();
+    double expectedMax = expected->getMax();
+    delete expected;
+    delete noise;
+    if (snir->getMin() != expectedMin || snir->getMax() != expectedMax) {
+        throw omnetpp::cRuntimeError(
+                "SNIR shortcut differs from the full computation: min %g instead of %g, max %g instead of %g",
+                snir->getMin(), expectedMin, snir->getMax(), expectedMax);
+    }
+}
+
+bool CullingRadioMedium::hasPerfectErrorModel(
+        const inet::physicallayer::IRadio *radio) const {
+    auto it = this->_perfectErrorModels.find(radio->getId());
+    if (it != this->_perfectErrorModels.end()) {
+        return it->second;
+    }
+    const omnetpp::cModule *receiver =
+            dynamic_cast<const omnetpp::cModule*>(radio->getReceiver());
+    bool isPerfect = receiver != nullptr
+            && dynamic_cast<PerfectErrorModel*>(receiver->getSubmodule(
+                    "errorModel")) != nullptr;
+    this->_perfectErrorModels.emplace(radio->getId(), isPerfect);
+    return isPerfect;
+}
+
+const inet::physicallayer::ISnir* CullingRadioMedium::computeScalarSnir(
+        const inet::physicallayer::IReception *reception,
+        const inet::physicallayer::IListening *listening,
+        const inet::physicallayer::IInterference *interference) const {
+    // without interfering receptions, the noise ScalarAnalogModel computes
+    // holds exactly the power changes of a scalar background noise in the
+    // band of the listening, so the SNIR of the background noise is the same;
+    // any interference, other analog models and other bands, where INET
+    // ignores the noise or throws, are left to the full computation
+    if (typeid(*this->analogModel)
+            != typeid(inet::physicallayer::ScalarAnalogModel)
+            || !interference->getInterferingReceptions()->empty()) {
+        return nullptr;
+    }
+    const inet::physicallayer::BandListening *bandListening = dynamic_cast<
+            const inet::physicallayer::BandListening*>(listening);
+    const inet::physicallayer::ScalarNoise *backgroundNoise = dynamic_cast<
+            const inet::physicallayer::ScalarNoise*>(
+            interference->getBackgroundNoise());
+    if (bandListening == nullptr || backgroundNoise == nullptr
+            || backgroundNoise->getCenterFrequency()
+                    != bandListening->getCenterFrequency()
+            || backgroundNoise->getBandwidth()
+                    > bandListening->getBandwidth()) {
+        return nullptr;
+    }
+    const inet::physicallayer::ISnir *snir = this->analogModel->computeSNIR(
+            reception, backgroundNoise);
+    // the background noise belongs to the cached interference, which is
+    // removed together with the cached SNIR, the values are computed anyway
+    snir->getMin();
+    snir->getMax();
+    snir->getMean();
+    return snir;
+}
+
+bool CullingRadioMedium::hasEarthObstacle() const {
+    if (this->physicalEnvironment == nullptr) {
+        return false;
+    }
+    for (int i = 0; i < this->physicalEnvironment->getNumObjects(); i++) {
+        const inet::physicalenvironment::IPhysicalObject *object =
+                this->physicalEnvironment->getObject(i);
+        auto sphere = dynamic_cast<const inet::Sphere*>(object->getShape());
+        // e.g. data/earthObstacle.xml, a sphere at the center of the Earth
+        if (sphere != nullptr && object->getPosition().length() < 1
+                && sphere->getRadius() >= this->_earthOcclusionRadius) {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool CullingRadioMedium::isOccludedByEarth(const inet::Coord &a,
+        const inet::Coord &b) const {
+    // closest point to the center of the Earth on the line of sight
+    inet::Coord direction = b - a;
+    double squaredLength = direction * direction;
+    if (squaredLength == 0) {
+        return false;
+    }
+    double t = -(a * direction) / squaredLength;
+    if (t <= 0 || t >= 1) {
+        // the closest point is one of the antennas
+        return false;
+    }
+    return (a + direction * t).length() < this->_earthOcclusionRadius;
+}
+
+}  // namespace estnet
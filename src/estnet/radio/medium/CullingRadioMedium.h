@@ -0,0 +1,158 @@
+//
+// Copyright (C) 2020 Computer Science VII: Robotics and Telematics - 
+// Julius-Maximilians-Universitaet Wuerzburg
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see http://www.gnu.org/licenses/.
+//
+
+
+#ifndef __RADIOS_CULLING_RADIO_MEDIUM_H__
+#define __RADIOS_CULLING_RADIO_MEDIUM_H__
+
+#include <map>
+#include <memory>
+#include <vector>
+
+#include <inet/common/geometry/common/Coord.h>
+#include <inet/physicallayer/common/packetlevel/RadioMedium.h>
+
+#include "estnet/common/ESTNETDefs.h"
+#include "estnet/contactplan/common/nanoflann.hpp"
+
+namespace estnet {
+
+/**
+ * Radio medium that only sends a signal to receivers which it can affect.
+ * Receivers farther away than the maximum interference range of the
+ * transmitter, the same limit as INET's interference range filter, are
+ * skipped, as well as receivers behind the Earth if an ideal obstacle loss
+ * blocks the signal anyway. No arrivals, listenings and receptions are
+ * computed for them. Candidate receivers are looked up in a kd-tree over
+ * the antenna positions, which is rebuilt when it is older than the update
+ * interval; the search radius grows with the maximum speed of the nodes
+ * since then.
+ * Optionally, the SNIR of receptions without interference at receivers with
+ * a ~PerfectErrorModel is computed from the background noise directly, which
+ * skips building the noise of the reception. Everything else is left to INET.
+ */
+class ESTNET_API CullingRadioMedium: public inet::physicallayer::RadioMedium {
+protected:
+    /**
+     * Antenna positions of the radios, dataset adaptor for nanoflann
+     */
+    struct PositionCloud {
+        std::vector<inet::Coord> positions;
+        /** @brief index of the radio in the radios of the medium */
+        std::vector<size_t> radioIndices;
+
+        inline size_t kdtree_get_point_count() const {
+            return positions.size();
+        }
+        inline double kdtree_get_pt(const size_t idx, int dim) const {
+            const inet::Coord &position = positions[idx];
+            return dim == 0 ? position.x : (dim == 1 ? position.y : position.z);
+        }
+        template<class BBOX>
+        bool kdtree_get_bbox(BBOX& /* bb */) const {
+            return false;
+        }
+    };
+    typedef nanoflann::KDTreeSingleIndexAdaptor<
+            nanoflann::L2_Simple_Adaptor<double, PositionCloud>, PositionCloud,
+            3, size_t> PositionTree;
+
+    /** @brief initialization */
+    virtual void initialize(int stage) override;
+    /** @brief records the number of culled receivers */
+    virtual void finish() override;
+    /** @brief sends the signal to all receivers not culled */
+    virtual void sendToAffectedRadios(inet::physicallayer::IRadio *transmitter,
+            const inet::physicallayer::ISignal *signal) override;
+
+    /** @brief rebuilds the kd-tree if it is outdated */
+    virtual void updatePositionTree();
+    /** @brief drops the kd-tree and all cached ranges */
+    virtual void invalidateCullingCache();
+    /**
+     * @brief returns the maximum interference range of the transmitter in m
+     * including the margin, infinity if the medium has no such limit
+     */
+    virtual double getInterferenceRange(
+            const inet::physicallayer::IRadio *transmitter);
+    /** @brief checks whether the receiver of the radio uses a ~PerfectErrorModel */
+    virtual bool hasPerfectErrorModel(
+            const inet::physicallayer::IRadio *radio) const;
+    /**
+     * @brief computes the SNIR of a reception without interfering receptions
+     * from the scalar background noise in the band of the listening, returns
+     * null for all other receptions
+     */
+    virtual const inet::physicallayer::ISnir* computeScalarSnir(
+            const inet::physicallayer::IReception *reception,
+            const inet::physicallayer::IListening *listening,
+            const inet::physicallayer::IInterference *interference) const;
+    /**
+     * @brief compares the SNIR of the shortcut with the SNIR computed from the
+     * noise by the analog model, throws if they differ
+     */
+    virtual void checkScalarSnir(const inet::physicallayer::IRadio *receiver,
+            const inet::physicallayer::ITransmission *transmission,
+            const inet::physicallayer::ISnir *snir) const;
+    /**
+     * @brief checks whether the physical environment holds a sphere around
+     * the center of the Earth at least as large as the occlusion sphere
+     */
+    virtual bool hasEarthObstacle() const;
+    /** @brief checks whether the line of sight between a and b crosses the Earth */
+    virtual bool isOccludedByEarth(const inet::Coord &a,
+            const inet::Coord &b) const;
+
+public:
+    /** @brief adds the radio and invalidates the culling caches */
+    virtual void addRadio(const inet::physicallayer::IRadio *radio) override;
+    /** @brief removes the radio and invalidates the culling caches */
+    virtual void removeRadio(const inet::physicallayer::IRadio *radio)
+            override;
+    /**
+     * @brief returns the SNIR of the reception, short-circuited for
+     * receptions without interference at receivers with a ~PerfectErrorModel
+     */
+    virtual const inet::physicallayer::ISnir* getSNIR(
+            const inet::physicallayer::IRadio *receiver,
+            const inet::physicallayer::ITransmission *transmission) const
+                    override;
+
+private:
+    bool _receiverCulling;
+    bool _perfectReceptionShortcut;
+    bool _perfectReceptionShortcutCheck;
+    double _earthOcclusionRadius;
+    double _rangeMargin;
+    omnetpp::simtime_t _positionUpdateInterval;
+    long _culledReceiverCount = 0;
+
+    bool _earthOcclusion = false;
+    PositionCloud _positionCloud;
+    std::unique_ptr<PositionTree> _positionTree;
+    omnetpp::simtime_t _positionTreeTime;
+    double _maxSpeed = 0;
+    // interference range including the margin by transmitter radio id
+    std::map<int, double> _interferenceRanges;
+    // whether the receiver has a perfect error model by radio id
+    mutable std::map<int, bool> _perfectErrorModels;
+};
+
+}  // namespace estnet
+
+#endif
@@ -18,8 +18,12 @@
 
 #include "ConstantSpeedPropagationWithMovement.h"
 
+#include <cmath>
+#include <limits>
+
 #include <inet/physicallayer/common/packetlevel/Arrival.h>
 #include <inet/physicallayer/common/packetlevel/Radio.h>
+#include <inet/physicallayer/contract/packetlevel/IRadioMedium.h>
 
 #include "estnet/mobility/contract/IExtendedMobility.h"
 
@@ -35,6 +39,9 @@ void ConstantSpeedPropagationWithMovement::initialize(int stage) {
         ignoreMovementDuringPropagation = par(
                 "ignoreMovementDuringPropagation");
         ignoreMovementDuringReception = par("ignoreMovementDuringReception");
+        lightTimeIteration = par("lightTimeIteration");
+        lightTimeTolerance = par("lightTimeTolerance").doubleValue();
+        maxLightTimeIterations = par("maxLightTimeIterations");
     }
 }
 
@@ -44,25 +51,95 @@ const Coord ConstantSpeedPropagationWithMovement::computeArrivalPosition(
     return extMobility->getPositionAtTime(time.dbl());
 }
 
+const Coord ConstantSpeedPropagationWithMovement::getEndPosition(
+        const ITransmission *transmission) const {
+    if (transmission->getId() != endPositionTransmissionId) {
+        auto transmitter = check_and_cast<const Radio*>(
+                transmission->getTransmitter());
+        endPositionCache = computeArrivalPosition(transmission->getEndTime(),
+                transmission->getStartPosition(),
+                transmitter->getAntenna()->getMobility());
+        endPositionTransmissionId = transmission->getId();
+    }
+    return endPositionCache;
+}
+
+double ConstantSpeedPropagationWithMovement::getMaxInterferenceRange() const {
+    if (maxInterferenceRange < 0) {
+        // the limits are known once the radios are initialized
+        auto medium = dynamic_cast<IRadioMedium*>(getParentModule());
+        double range = std::numeric_limits<double>::quiet_NaN();
+        if (medium != nullptr && medium->getMediumLimitCache() != nullptr) {
+            range = medium->getMediumLimitCache()->getMaxInterferenceRange().get();
+        }
+        maxInterferenceRange =
+                std::isnan(range) ?
+                        std::numeric_limits<double>::infinity() : range;
+    }
+    return maxInterferenceRange;
+}
+
+bool ConstantSpeedPropagationWithMovement::isInInterferenceRange(
+        double distance, IMobility *mobility) const {
+    // the receiver moves at most maxSpeed * propagationTime until the signal
+    // arrives, so a receiver outside the interference range even after that
+    // movement is not affected
+    double maxSpeed = mobility->getMaxSpeed();
+    return !std::isfinite(maxSpeed) || maxSpeed >= propagationSpeed.get()
+            || distance * (1 - maxSpeed / propagationSpeed.get())
+                    <= getMaxInterferenceRange();
+}
+
+simtime_t ConstantSpeedPropagationWithMovement::computeLightTime(
+        const simtime_t time, const Coord &position, IMobility *mobility,
+        double propagationTime, Coord &arrivalPosition) const {
+    // fixed-point iteration, the error shrinks by at least the contraction
+    // factor receiver speed / propagation speed per step, so the remaining
+    // error is bounded by the last step times factor / (1 - factor)
+    double maxSpeed = mobility->getMaxSpeed();
+    double factor = maxSpeed / propagationSpeed.get();
+    double errorPerStep =
+            std::isfinite(factor) && factor < 1 ? factor / (1 - factor) : 1;
+    for (int i = 0; i < maxLightTimeIterations; i++) {
+        arrivalPosition = computeArrivalPosition(time + propagationTime,
+                position, mobility);
+        double nextPropagationTime = position.distance(arrivalPosition)
+                / propagationSpeed.get();
+        double step = std::abs(nextPropagationTime - propagationTime);
+        propagationTime = nextPropagationTime;
+        if (step * errorPerStep <= lightTimeTolerance) {
+            break;
+        }
+    }
+    return propagationTime;
+}
+
 const IArrival* ConstantSpeedPropagationWithMovement::computeArrival(
         const ITransmission *transmission, IMobility *mobility) const {
     arrivalComputationCount++;
     const simtime_t startTime = transmission->getStartTime();
     const simtime_t endTime = transmission->getEndTime();
     const Coord startPosition = transmission->getStartPosition();
-    auto transmitter = check_and_cast<const Radio*>(
-            transmission->getTransmitter());
     const Coord endPosition =
             ignoreMovementDuringTransmission ?
                     transmission->getEndPosition() :
-                    computeArrivalPosition(endTime, startPosition,
-                            transmitter->getAntenna()->getMobility());
-    const Coord startArrivalPosition =
+                    getEndPosition(transmission);
+    Coord startArrivalPosition =
             ignoreMovementDuringPropagation ?
                     mobility->getCurrentPosition() :
                     computeArrivalPosition(startTime, startPosition, mobility);
-    const simtime_t startPropagationTime = startPosition.distance(
+    simtime_t startPropagationTime = startPosition.distance(
             startArrivalPosition) / propagationSpeed.get();
+    // the light time is only solved for receivers the signal can reach,
+    // the others keep the positions at the time of sending
+    const bool solveLightTime = lightTimeIteration
+            && !ignoreMovementDuringPropagation
+            && isInInterferenceRange(startPosition.distance(
+                    startArrivalPosition), mobility);
+    if (solveLightTime) {
+        startPropagationTime = computeLightTime(startTime, startPosition,
+                mobility, startPropagationTime.dbl(), startArrivalPosition);
+    }
     const simtime_t startArrivalTime = startTime + startPropagationTime;
     const Quaternion startArrivalOrientation =
             mobility->getCurrentAngularPosition();
@@ -81,10 +158,18 @@ const IArrival* ConstantSpeedPropagationWithMovement::computeArrival(
                 endArrivalPosition, startArrivalOrientation,
                 endArrivalOrientation);
     } else {
-        const Coord endArrivalPosition = computeArrivalPosition(endTime,
-                endPosition, mobility);
-        const simtime_t endPropagationTime = endPosition.distance(
-                endArrivalPosition) / propagationSpeed.get();
+        Coord endArrivalPosition;
+        simtime_t endPropagationTime;
+        if (solveLightTime) {
+            // the propagation time changes little during the transmission
+            endPropagationTime = computeLightTime(endTime, endPosition,
+                    mobility, startPropagationTime.dbl(), endArrivalPosition);
+        } else {
+            endArrivalPosition = computeArrivalPosition(endTime, endPosition,
+                    mobility);
+            endPropagationTime = endPosition.distance(endArrivalPosition)
+                    / propagationSpeed.get();
+        }
         const simtime_t endArrivalTime = endTime + endPropagationTime;
         const simtime_t preambleDuration = transmission->getPreambleDuration();
         const simtime_t headerDuration = transmission->getHeaderDuration();
@@ -32,13 +32,28 @@ namespace estnet {
 /**
  * Implements a propagation that allows to take into account movements of the nodes
  * This is crucial for satellites, as fast velocities may result into
- * weird behavior otherwise
+ * weird behavior otherwise.
+ * Optionally, the receiver position is solved for the time the signal arrives
+ * (light time). The transmitter's end position is cached per transmission, so a
+ * broadcast evaluates the transmitter's movement only once.
  */
 class ESTNET_API ConstantSpeedPropagationWithMovement: public ConstantSpeedPropagation {
 protected:
     bool ignoreMovementDuringTransmission;
     bool ignoreMovementDuringPropagation;
     bool ignoreMovementDuringReception;
+    bool lightTimeIteration;
+    double lightTimeTolerance;
+    int maxLightTimeIterations;
+
+private:
+    // end position of the transmitter of the last transmission, it is the
+    // same for all arrivals of a broadcast
+    mutable int endPositionTransmissionId = -1;
+    mutable Coord endPositionCache;
+    // receivers farther away than this cannot be affected by the signal,
+    // negative until it is read from the radio medium
+    mutable double maxInterferenceRange = -1;
 
 protected:
     /**
@@ -59,6 +74,39 @@ protected:
     virtual const Coord computeArrivalPosition(const simtime_t startTime,
             const Coord startPosition, IMobility *mobility) const override;
 
+    /**
+     * Returns the position of the transmitter at the end of a transmission
+     * @param transmission: transmitted signal/packet
+     * @return Coord: position of transmitting node at the end of transmission
+     */
+    virtual const Coord getEndPosition(const ITransmission *transmission) const;
+
+    /**
+     * Returns whether the signal of a transmitter at the given distance of a
+     * receiver can reach the receiver within the interference range, taking
+     * into account the movement of the receiver during propagation
+     */
+    virtual bool isInInterferenceRange(double distance,
+            IMobility *mobility) const;
+
+    /**
+     * Computes the propagation time of a signal sent at a position and time to
+     * a moving receiver, by iterating the receiver position at arrival until
+     * the propagation time is known to be within lightTimeTolerance
+     * @param time: time at which the signal leaves the transmitter
+     * @param position: position of the transmitter at that time
+     * @param mobility: mobility of receiving node
+     * @param propagationTime: first guess of the propagation time
+     * @param arrivalPosition: set to the position of the receiver at arrival
+     * @return propagation time
+     */
+    virtual simtime_t computeLightTime(const simtime_t time,
+            const Coord &position, IMobility *mobility,
+            double propagationTime, Coord &arrivalPosition) const;
+
+    /** @brief returns the range beyond which signals have no effect */
+    virtual double getMaxInterferenceRange() const;
+
 public:
     /**
      * Computes a arrival of a transmission at a receiving node
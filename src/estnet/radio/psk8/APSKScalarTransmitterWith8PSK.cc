@@ -32,7 +32,7 @@ void APSKScalarTransmitterWith8PSK::initialize(int stage) {
         if (par("modulation").stdstringValue() != "8PSK") {
             throw omnetpp::cRuntimeError("Only 8PSK modulation is supported");
         }
-        modulation = new PSK8Modulation();
+        modulation = new PSK8Modulation(par("useBerLookupTable").boolValue());
         centerFrequency = inet::Hz(
                 par("centerFrequency").doubleValueInUnit("Hz"));
         bandwidth = inet::Hz(par("bandwidth").doubleValueInUnit("Hz"));
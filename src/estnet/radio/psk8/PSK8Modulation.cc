@@ -21,16 +21,24 @@
 #include <cmath>
 
 #include "estnet/global_config.h"
+#include "estnet/radio/errormodel/BerLookupTable.h"
 
 namespace estnet {
 
+double PSK8Modulation::calculateBER(double snirPerBit) {
+    //https://www.unilim.fr/pages_perso/vahid/notes/ber_awgn.pdf
+    return ((1 / log2(8)) * erfc(sqrt(snirPerBit * log2(8)) * sin( PI / 8)));
+}
+
 double PSK8Modulation::calculateBER(double snir, inet::Hz bandwidth,
         inet::bps bitrate) const {
-    //https://www.unilim.fr/pages_perso/vahid/notes/ber_awgn.pdf
-    return ((1 / log2(8))
-            * erfc(
-                    sqrt(snir * bandwidth.get() / bitrate.get() * log2(8))
-                            * sin( PI / 8)));
+    if (this->_useLookupTable) {
+        // shared by all modulation instances, built on first use
+        static const BerLookupTable table(
+                static_cast<double (*)(double)>(&PSK8Modulation::calculateBER));
+        return table.lookup(snir * bandwidth.get() / bitrate.get());
+    }
+    return calculateBER(snir * bandwidth.get() / bitrate.get());
 }
 
 double PSK8Modulation::calculateSER(double snir, inet::Hz bandwidth,
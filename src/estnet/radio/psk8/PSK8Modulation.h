@@ -27,12 +27,25 @@ namespace estnet {
 
 /**
  * Implementes BER & SER calculations for the 8PSK modulation. (Class names cannot begin with numbers)
+ * The BER can be taken from a precomputed ~BerLookupTable instead of
+ * evaluating erfc for every call.
  */
 class ESTNET_API PSK8Modulation: public inet::physicallayer::ApskModulationBase {
+private:
+    bool _useLookupTable;
 public:
-    PSK8Modulation() :
+    PSK8Modulation(bool useLookupTable = false) :
             inet::physicallayer::ApskModulationBase(
-                    new std::vector<inet::physicallayer::ApskSymbol>()) {
+                    new std::vector<inet::physicallayer::ApskSymbol>()), _useLookupTable(
+                    useLookupTable) {
+    }
+
+    /** @brief BER as a function of snir * bandwidth / bitrate */
+    static double calculateBER(double snirPerBit);
+
+    /** @brief whether the BER is taken from the precomputed table */
+    bool usesLookupTable() const {
+        return this->_useLookupTable;
     }
 
     /** @brief Prints this object to the provided output stream */
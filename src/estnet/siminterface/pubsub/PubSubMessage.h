@@ -19,11 +19,11 @@
 #ifndef PUBSUB_MESSAGE_H_
 #define PUBSUB_MESSAGE_H_
 
-#define PUBSUB_SIGNAL_NAME                                                       \
-  "PubSubSignal" ///< Global name of the signal, where all messages for PubSub will be published
-
 #include "estnet/common/ESTNETDefs.h"
+#include <cstdint>
+#include <cstdlib>
 #include <string>
+#include <vector>
 
 namespace estnet {
 
@@ -31,15 +31,110 @@ namespace estnet {
 typedef std::string tPubSubKey;
 // type for the value of a PubSub-Message
 typedef std::string tPubSubValue;
+// type for the interned id of a PubSub-Topic, see TopicRegistry
+typedef int tPubSubTopicId;
+// type for a vector value of a PubSub-Message, e.g. a position
+typedef std::vector<double> tPubSubVector;
+// type for a binary value of a PubSub-Message
+typedef std::vector<uint8_t> tPubSubBlob;
+
+// type of the value carried by a PubSub-Message
+enum class PubSubPayloadType {
+    STRING, NUMBER, VECTOR, BLOB
+};
 
 /**
- * This represents the object which gets emitted on the signal. Subscribers will get the message and check if they need it.
+ * This represents the object which gets delivered to the subscribers of its topic.
  * They check the key value. If they want the message, they can use the value provided.
+ * Besides strings the value can be a number, a vector or a binary blob, so that typed values do
+ * not need to be formatted to text by the publisher and parsed back by every subscriber.
+ *
+ * The message only points to the key, the string, vector and blob values of the publisher,
+ * they are not copied. These belong to the publisher and live until it returns from
+ * publishing, so a message (or a copy of it) is only valid while it is dispatched.
+ * Subscribers that need the key or value later have to copy them.
  **/
 class ESTNET_API PubSubMsg: public omnetpp::cObject {
 public:
-    tPubSubKey key;
-    tPubSubValue value;
+    PubSubMsg(const tPubSubKey &key, const tPubSubValue &value) :
+            _key(&key), _value(&value), _type(PubSubPayloadType::STRING) {
+    }
+    PubSubMsg(const tPubSubKey &key, double number) :
+            _key(&key), _type(PubSubPayloadType::NUMBER), _number(number) {
+    }
+    PubSubMsg(const tPubSubKey &key, const tPubSubVector &vector) :
+            _key(&key), _type(PubSubPayloadType::VECTOR), _vector(&vector) {
+    }
+    PubSubMsg(const tPubSubKey &key, const tPubSubBlob &blob) :
+            _key(&key), _type(PubSubPayloadType::BLOB), _blob(&blob) {
+    }
+    // the message would point to a destroyed temporary
+    PubSubMsg(tPubSubKey &&key, const tPubSubValue &value) = delete;
+    PubSubMsg(const tPubSubKey &key, tPubSubValue &&value) = delete;
+    PubSubMsg(tPubSubKey &&key, double number) = delete;
+    PubSubMsg(const tPubSubKey &key, tPubSubVector &&vector) = delete;
+    PubSubMsg(const tPubSubKey &key, tPubSubBlob &&blob) = delete;
+
+    tPubSubTopicId topicId = -1;
+
+    /** @brief returns the topic the message was published on */
+    const tPubSubKey& getKey() const {
+        return *_key;
+    }
+    /** @brief returns the type of the value */
+    PubSubPayloadType getType() const {
+        return _type;
+    }
+    /** @brief returns the string value, empty for typed values */
+    const tPubSubValue& getValue() const {
+        return _value != nullptr ? *_value : emptyValue();
+    }
+    /** @brief returns the numeric value, string values are parsed */
+    double getNumber() const {
+        if (_type == PubSubPayloadType::STRING) {
+            return std::atof(_value->c_str());
+        }
+        checkType(PubSubPayloadType::NUMBER);
+        return _number;
+    }
+    /** @brief returns the vector value without copying */
+    const tPubSubVector& getVector() const {
+        checkType(PubSubPayloadType::VECTOR);
+        return *_vector;
+    }
+    /** @brief returns the binary value without copying */
+    const tPubSubBlob& getBlob() const {
+        checkType(PubSubPayloadType::BLOB);
+        return *_blob;
+    }
+    /** @brief returns the value as string, numbers are formatted */
+    std::string getString() const {
+        if (_type == PubSubPayloadType::NUMBER) {
+            return std::to_string(_number);
+        }
+        checkType(PubSubPayloadType::STRING);
+        return *_value;
+    }
+
+private:
+    static const tPubSubValue& emptyValue() {
+        static const tPubSubValue empty;
+        return empty;
+    }
+    void checkType(PubSubPayloadType type) const {
+        if (_type != type) {
+            throw omnetpp::cRuntimeError(
+                    "PubSub message on topic %s has a different value type",
+                    _key->c_str());
+        }
+    }
+
+    const tPubSubKey *_key;
+    const tPubSubValue *_value = nullptr;
+    PubSubPayloadType _type;
+    double _number = 0;
+    const tPubSubVector *_vector = nullptr;
+    const tPubSubBlob *_blob = nullptr;
 };
 
 }  // namespace estnet
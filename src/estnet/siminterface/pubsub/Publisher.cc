@@ -20,24 +20,45 @@
 
 #include <omnetpp.h>
 
+#include "TopicRegistry.h"
+
 namespace estnet {
 
 void Publisher::initialize() {
-    //register the publisher to the global signal name
-    _valueSigId = registerSignal(PUBSUB_SIGNAL_NAME);
     EV << "publisher" << std::endl;
 }
 
 void Publisher::publishValue(tPubSubValue value, tPubSubKey key) {
-    PubSubMsg msg;
-    if (key.compare("") == 0) {
+    PubSubMsg msg(key, value);
+    publishMessage(msg);
+}
+
+void Publisher::publishNumber(double value, const tPubSubKey &key) {
+    PubSubMsg msg(key, value);
+    publishMessage(msg);
+}
+
+void Publisher::publishVector(const tPubSubVector &value,
+        const tPubSubKey &key) {
+    PubSubMsg msg(key, value);
+    publishMessage(msg);
+}
+
+void Publisher::publishBlob(const tPubSubBlob &value,
+        const tPubSubKey &key) {
+    PubSubMsg msg(key, value);
+    publishMessage(msg);
+}
+
+void Publisher::publishMessage(PubSubMsg &msg) {
+    if (msg.getKey().empty()) {
         throw omnetpp::cRuntimeError(
                 "Cannot publish values to an empty topic.");
     }
-    msg.key = key;
-    msg.value = value;
-    // publish the message to the global signal
-    emit(_valueSigId, &msg);
+    // dispatch only to the subscribers of the topic
+    TopicRegistry &topicRegistry = TopicRegistry::getInstance();
+    msg.topicId = topicRegistry.internTopic(msg.getKey());
+    topicRegistry.publish(this, &msg);
 }
 
 }  // namespace estnet
@@ -46,7 +46,14 @@ protected:
      * @param key: the topic name on which the value is published
      */
     virtual void publishValue(tPubSubValue value, tPubSubKey key);
-    simsignal_t _valueSigId;
+    /** @brief publishes a numeric value to the topic key */
+    virtual void publishNumber(double value, const tPubSubKey &key);
+    /** @brief publishes a vector value to the topic key, subscribers get a reference to it */
+    virtual void publishVector(const tPubSubVector &value, const tPubSubKey &key);
+    /** @brief publishes a binary value to the topic key, subscribers get a reference to it */
+    virtual void publishBlob(const tPubSubBlob &value, const tPubSubKey &key);
+    /** @brief delivers the message to the subscribers of its topic */
+    void publishMessage(PubSubMsg &msg);
 };
 
 }  // namespace estnet
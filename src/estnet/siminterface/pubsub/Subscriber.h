@@ -28,21 +28,23 @@
 
 namespace estnet {
 
-class ESTNET_API Subscriber: public omnetpp::cListener {
+/**
+ * Receives messages of the PubSub system for all subscribed topics.
+ * Subscriptions are registered at the ~TopicRegistry, which dispatches
+ * published messages only to matching subscribers.
+ **/
+class ESTNET_API Subscriber {
+    friend class TopicRegistry;
 public:
-    explicit Subscriber(omnetpp::cComponent *ownerComponent = nullptr) {
-        if (ownerComponent == nullptr) {
-            // No top level owner component defined -> register listener at simulation
-            // top level!
-            omnetpp::getSimulation()->getSystemModule()->subscribe(
-            PUBSUB_SIGNAL_NAME, this);
-        } else {
-            // subscribe to the value update signal at the level of the ownerComponent
-            // (e.g. a satellite module)
-            ownerComponent->subscribe(PUBSUB_SIGNAL_NAME, this);
-        }
+    explicit Subscriber(omnetpp::cComponent *ownerComponent = nullptr) :
+            _scope(dynamic_cast<omnetpp::cModule*>(ownerComponent)) {
+        // No top level owner component defined -> receive messages published
+        // anywhere in the simulation, otherwise only messages published at the
+        // level of the ownerComponent (e.g. a satellite module) or below
     }
 
+    virtual ~Subscriber();
+
     /**
      * Returns a list of keys this module subscribed to.
      * @return list of keys needed by this module
@@ -51,19 +53,6 @@ public:
         return _neededMessageKeys;
     }
 
-    /**
-     * Callback function for received pubsub signal. As pubsub only emits PubSubMsg, it can be assumed
-     * that obj always contains one, but it gets checked aswell.
-     * @param source Component that emitted the signal
-     * @param signalID Signal identification number
-     * @param obj cObject pointer, that contains the actual message (must be of type
-     * PubSubMsg)
-     * @param details not used here, can be safely assumed to be NULL
-     */
-    virtual void receiveSignal(omnetpp::cComponent *source,
-            omnetpp::simsignal_t signalID, omnetpp::cObject *obj,
-            omnetpp::cObject *details) override;
-
 protected:
     /**
      * This function is called whenever a new message arrives that has a topic this
@@ -83,11 +72,13 @@ protected:
 
 private:
     /**
-     * Internal function to evaluate, whether the key of a message matches with a topic this subscriber subscribed to.
-     * This also implements a wildcard functionality, equal to what MQTT uses, so we are compatible with it.
-     *
+     * Evaluates whether messages published by the given component reach
+     * this subscriber, i.e. whether the publisher lies within the scope.
      */
-    bool needsMessage(tPubSubKey msgKey) const;
+    bool isInScope(omnetpp::cComponent *publisher) const;
+
+    omnetpp::cModule *_scope; ///< module below which messages are received, nullptr for all
+
 };
 
 }  // namespace estnet
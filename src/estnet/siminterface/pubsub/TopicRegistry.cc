@@ -0,0 +1,200 @@
+//
+// Copyright (C) 2020 Computer Science VII: Robotics and Telematics - 
+// Julius-Maximilians-Universitaet Wuerzburg
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see http://www.gnu.org/licenses/.
+//
+
+
+#include "TopicRegistry.h"
+
+#include <algorithm>
+
+#include "Subscriber.h"
+
+namespace estnet {
+
+TopicRegistry& TopicRegistry::getInstance() {
+    static TopicRegistry instance;
+    return instance;
+}
+
+tPubSubTopicId TopicRegistry::internTopic(const tPubSubKey &topic) {
+    auto it = this->_topicIds.find(topic);
+    if (it != this->_topicIds.end()) {
+        return it->second;
+    }
+    tPubSubTopicId topicId = this->_topics.size();
+    this->_topicIds.emplace(topic, topicId);
+    this->_topics.push_back(topic);
+    this->_cachedSubscribers.emplace_back();
+    this->_cacheValid.push_back(false);
+    return topicId;
+}
+
+const tPubSubKey& TopicRegistry::getTopic(tPubSubTopicId topicId) const {
+    return this->_topics.at(topicId);
+}
+
+void TopicRegistry::addSubscription(Subscriber *subscriber,
+        const tPubSubKey &topicFilter) {
+    std::vector<std::string> levels = splitLevels(topicFilter);
+    TrieNode *node = &this->_root;
+    for (size_t i = 0; i < levels.size(); i++) {
+        const std::string &level = levels[i];
+        if (level == "#") {
+            if (i != levels.size() - 1) {
+                throw omnetpp::cRuntimeError(
+                        "Wildcard '#' must be the last level of topic %s",
+                        topicFilter.c_str());
+            }
+            node->multiLevelWildcard.push_back(subscriber);
+            node = nullptr;
+            break;
+        } else if (level == "+") {
+            if (!node->singleLevelWildcard) {
+                node->singleLevelWildcard.reset(new TrieNode());
+            }
+            node = node->singleLevelWildcard.get();
+        } else {
+            std::unique_ptr<TrieNode> &child = node->children[level];
+            if (!child) {
+                child.reset(new TrieNode());
+            }
+            node = child.get();
+        }
+    }
+    if (node != nullptr) {
+        node->subscribers.push_back(subscriber);
+    }
+    this->_subscriptions[subscriber].push_back(topicFilter);
+    if (this->_subscriptionOrder.find(subscriber)
+            == this->_subscriptionOrder.end()) {
+        this->_subscriptionOrder[subscriber] = this->_nextSubscriptionOrder++;
+    }
+    this->invalidateCache();
+}
+
+void TopicRegistry::removeSubscriber(Subscriber *subscriber) {
+    auto subIt = this->_subscriptions.find(subscriber);
+    if (subIt != this->_subscriptions.end()) {
+        for (const tPubSubKey &topicFilter : subIt->second) {
+            TrieNode *node = &this->_root;
+            for (const std::string &level : splitLevels(topicFilter)) {
+                if (level == "#") {
+                    auto &subs = node->multiLevelWildcard;
+                    subs.erase(std::remove(subs.begin(), subs.end(), subscriber),
+                            subs.end());
+                    node = nullptr;
+                    break;
+                } else if (level == "+") {
+                    node = node->singleLevelWildcard.get();
+                } else {
+                    node = node->children.at(level).get();
+                }
+            }
+            if (node != nullptr) {
+                auto &subs = node->subscribers;
+                subs.erase(std::remove(subs.begin(), subs.end(), subscriber),
+                        subs.end());
+            }
+        }
+        this->_subscriptions.erase(subIt);
+    }
+    this->_subscriptionOrder.erase(subscriber);
+
+    if (this->_subscriptions.empty()) {
+        // all subscribers are gone, e.g. because the network was torn down
+        this->_root = TrieNode();
+        this->_topicIds.clear();
+        this->_topics.clear();
+        this->_cachedSubscribers.clear();
+        this->_cacheValid.clear();
+        this->_nextSubscriptionOrder = 0;
+    } else {
+        this->invalidateCache();
+    }
+}
+
+const std::vector<Subscriber*>& TopicRegistry::getSubscribers(
+        tPubSubTopicId topicId) {
+    std::vector<Subscriber*> &subscribers = this->_cachedSubscribers.at(
+            topicId);
+    if (!this->_cacheValid[topicId]) {
+        subscribers.clear();
+        this->collectSubscribers(this->_root,
+                splitLevels(this->_topics[topicId]), 0, subscribers);
+        // a subscriber might match with several of its filters
+        std::sort(subscribers.begin(), subscribers.end(),
+                [this](Subscriber *a, Subscriber *b) {
+                    return this->_subscriptionOrder.at(a)
+                            < this->_subscriptionOrder.at(b);
+                });
+        subscribers.erase(std::unique(subscribers.begin(), subscribers.end()),
+                subscribers.end());
+        this->_cacheValid[topicId] = true;
+    }
+    return subscribers;
+}
+
+void TopicRegistry::publish(omnetpp::cComponent *publisher,
+        PubSubMsg *pubSubMsg) {
+    // copy, as handlers might subscribe or publish themselves
+    std::vector<Subscriber*> subscribers = this->getSubscribers(
+            pubSubMsg->topicId);
+    for (Subscriber *subscriber : subscribers) {
+        if (subscriber->isInScope(publisher)) {
+            subscriber->receivedPubSubMessage(pubSubMsg);
+        }
+    }
+}
+
+std::vector<std::string> TopicRegistry::splitLevels(const tPubSubKey &topic) {
+    std::vector<std::string> levels;
+    size_t start = 0;
+    size_t pos;
+    while ((pos = topic.find('/', start)) != std::string::npos) {
+        levels.push_back(topic.substr(start, pos - start));
+        start = pos + 1;
+    }
+    levels.push_back(topic.substr(start));
+    return levels;
+}
+
+void TopicRegistry::collectSubscribers(const TrieNode &node,
+        const std::vector<std::string> &levels, size_t level,
+        std::vector<Subscriber*> &result) const {
+    if (level == levels.size()) {
+        result.insert(result.end(), node.subscribers.begin(),
+                node.subscribers.end());
+        return;
+    }
+    // '#' matches all remaining levels
+    result.insert(result.end(), node.multiLevelWildcard.begin(),
+            node.multiLevelWildcard.end());
+    auto childIt = node.children.find(levels[level]);
+    if (childIt != node.children.end()) {
+        this->collectSubscribers(*childIt->second, levels, level + 1, result);
+    }
+    if (node.singleLevelWildcard) {
+        this->collectSubscribers(*node.singleLevelWildcard, levels, level + 1,
+                result);
+    }
+}
+
+void TopicRegistry::invalidateCache() {
+    std::fill(this->_cacheValid.begin(), this->_cacheValid.end(), false);
+}
+
+}  // namespace estnet
@@ -0,0 +1,124 @@
+//
+// Copyright (C) 2020 Computer Science VII: Robotics and Telematics - 
+// Julius-Maximilians-Universitaet Wuerzburg
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see http://www.gnu.org/licenses/.
+//
+
+
+#ifndef PUBSUB_TOPIC_REGISTRY_H_
+#define PUBSUB_TOPIC_REGISTRY_H_
+
+#include <map>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <omnetpp.h>
+
+#include "PubSubMessage.h"
+
+namespace estnet {
+
+class Subscriber;
+
+/**
+ * Central registry of all topic subscriptions of the PubSub system.
+ * Topic filters of the subscribers are compiled into a trie, which has one
+ * level per topic level and extra nodes for the wildcards '+' (matches
+ * exactly one level) and '#' (matches all remaining levels, at least one).
+ * Unlike MQTT, "a/#" does not match the parent level "a". All levels are
+ * compared, including the one before the first '/', so a filter without '/'
+ * only matches the equal topic.
+ * Published topics are interned to integer ids, the subscribers matching a
+ * topic id are cached until the subscriptions change, so that publishing a
+ * message only dispatches to the subscribers that actually need it.
+ **/
+class ESTNET_API TopicRegistry {
+public:
+    /** @brief returns the registry shared by all publishers and subscribers */
+    static TopicRegistry& getInstance();
+
+    /**
+     * Returns the integer id of the given topic, assigning a new one if the
+     * topic was not seen before.
+     * @param topic: topic name without wildcards
+     * @return id of the topic
+     */
+    tPubSubTopicId internTopic(const tPubSubKey &topic);
+    /** @brief returns the topic name for the given interned id */
+    const tPubSubKey& getTopic(tPubSubTopicId topicId) const;
+
+    /**
+     * Adds a topic filter of the given subscriber to the trie.
+     * @param subscriber: the subscriber receiving matching messages
+     * @param topicFilter: topic name, potentially containing wildcards
+     */
+    void addSubscription(Subscriber *subscriber, const tPubSubKey &topicFilter);
+    /** @brief removes all topic filters of the given subscriber */
+    void removeSubscriber(Subscriber *subscriber);
+
+    /**
+     * Returns all subscribers with a topic filter matching the topic,
+     * in the order they subscribed first.
+     * @param topicId: interned id of the published topic
+     * @return subscribers needing messages of the topic
+     */
+    const std::vector<Subscriber*>& getSubscribers(tPubSubTopicId topicId);
+
+    /**
+     * Delivers the message to all subscribers of its topic, which
+     * are listening within the scope of the publishing module.
+     * @param publisher: component that publishes the message
+     * @param pubSubMsg: message with interned topic id
+     */
+    void publish(omnetpp::cComponent *publisher, PubSubMsg *pubSubMsg);
+
+private:
+    /** one topic level of the compiled subscriptions */
+    struct TrieNode {
+        std::map<std::string, std::unique_ptr<TrieNode>> children;
+        std::unique_ptr<TrieNode> singleLevelWildcard; // '+'
+        std::vector<Subscriber*> subscribers;          // filters ending here
+        std::vector<Subscriber*> multiLevelWildcard;   // filters ending with '#' here
+    };
+
+    TopicRegistry() {
+    }
+
+    /** @brief splits a topic name into its levels */
+    static std::vector<std::string> splitLevels(const tPubSubKey &topic);
+    /** @brief collects the subscribers matching the topic levels from level on */
+    void collectSubscribers(const TrieNode &node,
+            const std::vector<std::string> &levels, size_t level,
+            std::vector<Subscriber*> &result) const;
+    /** @brief drops the cached subscribers of all topics */
+    void invalidateCache();
+
+    TrieNode _root;
+    std::unordered_map<tPubSubKey, tPubSubTopicId> _topicIds;
+    std::vector<tPubSubKey> _topics;
+    std::vector<std::vector<Subscriber*>> _cachedSubscribers;
+    std::vector<bool> _cacheValid;
+    // topic filters of each subscriber, needed to remove it from the trie
+    std::map<Subscriber*, std::vector<tPubSubKey>> _subscriptions;
+    // order in which subscribers subscribed first, keeps dispatching deterministic
+    std::map<Subscriber*, long> _subscriptionOrder;
+    long _nextSubscriptionOrder = 0;
+};
+
+}  // namespace estnet
+
+#endif
@@ -0,0 +1,241 @@
+//
+// Copyright (C) 2020 Computer Science VII: Robotics and Telematics - 
+// Julius-Maximilians-Universitaet Wuerzburg
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see http://www.gnu.org/licenses/.
+//
+
+
+#include "PubSubTcpBridge.h"
+
+#include "estnet/protocol/common/SocketUtils.h"
+#include "estnet/siminterface/tcpinterface/PubSubTcpScheduler.h"
+#include "estnet/siminterface/tcpinterface/extMessageHandler.h"
+
+namespace estnet {
+
+Define_Module(PubSubTcpBridge);
+
+PubSubTcpBridge::PubSubTcpBridge() :
+        Subscriber() {
+}
+
+PubSubTcpBridge::~PubSubTcpBridge() {
+    PubSubTcpScheduler *scheduler = dynamic_cast<PubSubTcpScheduler*>(
+            omnetpp::getSimulation()->getScheduler());
+    if (scheduler != nullptr) {
+        scheduler->removeBridge(this);
+    }
+    this->closeSockets();
+    this->cancelAndDelete(this->_dataArrived);
+    this->cancelAndDelete(this->_pollTimer);
+}
+
+void PubSubTcpBridge::initialize() {
+    SimplePublisher::initialize();
+    this->_dataArrived = new omnetpp::cMessage("dataArrived");
+    this->_pollInterval = this->par("pollInterval");
+    this->_maxSendBufferSize = this->par("maxSendBufferSize").intValue();
+
+    int port = this->par("port");
+    this->_listenSockfd = open_tcp_server_socket(port);
+    if (this->_listenSockfd < 0
+            || set_socket_nonblocking(this->_listenSockfd) < 0) {
+        throw omnetpp::cRuntimeError("Could not listen on TCP port %d", port);
+    }
+    // port 0 lets the system choose a free port
+    this->_port = get_socket_port(this->_listenSockfd);
+    EV_INFO << "Listening for external controllers on TCP port " << this->_port
+                   << omnetpp::endl;
+
+    // topics forwarded to the connected controllers
+    for (const std::string &topic : omnetpp::cStringTokenizer(
+            this->par("forwardTopics").stringValue()).asVector()) {
+        this->subscribeTopic(topic);
+    }
+
+    PubSubTcpScheduler *scheduler = dynamic_cast<PubSubTcpScheduler*>(
+            getSimulation()->getScheduler());
+    if (scheduler != nullptr) {
+        scheduler->addBridge(this);
+    } else if (this->_pollInterval > 0) {
+        this->_pollTimer = new omnetpp::cMessage("pollTimer");
+        this->scheduleAt(omnetpp::simTime() + this->_pollInterval,
+                this->_pollTimer);
+    } else {
+        throw omnetpp::cRuntimeError(
+                "PubSubTcpBridge needs scheduler-class = \"estnet::PubSubTcpScheduler\" "
+                "or a pollInterval greater than zero");
+    }
+
+    WATCH(this->_numReceived);
+    WATCH(this->_numSent);
+    WATCH(this->_numInvalid);
+    WATCH(this->_numOverflows);
+}
+
+void PubSubTcpBridge::handleMessage(omnetpp::cMessage *msg) {
+    if (msg == this->_dataArrived) {
+        this->publishReceivedMessages();
+    } else if (msg == this->_pollTimer) {
+        if (this->receiveAvailableData()) {
+            this->publishReceivedMessages();
+        }
+        this->scheduleAt(omnetpp::simTime() + this->_pollInterval,
+                this->_pollTimer);
+    } else {
+        throw omnetpp::cRuntimeError("Unexpected message received");
+    }
+}
+
+void PubSubTcpBridge::finish() {
+    recordScalar("receivedMessages", this->_numReceived);
+    recordScalar("sentMessages", this->_numSent);
+    recordScalar("invalidMessages", this->_numInvalid);
+    recordScalar("sendBufferOverflows", this->_numOverflows);
+    this->closeSockets();
+}
+
+void PubSubTcpBridge::getSockets(std::vector<int> &sockets) const {
+    if (this->_listenSockfd >= 0) {
+        sockets.push_back(this->_listenSockfd);
+    }
+    for (const Connection &connection : this->_connections) {
+        sockets.push_back(connection.sockfd);
+    }
+}
+
+bool PubSubTcpBridge::receiveAvailableData() {
+    if (this->_listenSockfd < 0) {
+        return false;
+    }
+    // accept all pending connections
+    int sockfd;
+    while ((sockfd = accept(this->_listenSockfd, nullptr, nullptr)) >= 0) {
+        if (set_socket_nonblocking(sockfd) < 0) {
+            close_socket(sockfd);
+            continue;
+        }
+        this->_connections.emplace_back();
+        this->_connections.back().sockfd = sockfd;
+    }
+
+    bool framesAvailable = false;
+    for (auto it = this->_connections.begin(); it != this->_connections.end();) {
+        Connection &connection = *it;
+        bool closed = false;
+        // read everything available, a single read may contain several frames
+        while (true) {
+            size_t available;
+            char *buffer = connection.rxBuffer.prepareWrite(4096, available);
+            ssize_t received = recv(connection.sockfd, buffer, available, 0);
+            if (received > 0) {
+                connection.rxBuffer.commitWrite(received);
+            } else {
+                closed = received == 0 || !socket_would_block();
+                break;
+            }
+        }
+        // sending might have been blocked before
+        closed = closed || !this->flush(connection);
+        framesAvailable = framesAvailable || connection.rxBuffer.hasFrame();
+        if (closed && !connection.rxBuffer.hasFrame()) {
+            close_socket(connection.sockfd);
+            it = this->_connections.erase(it);
+        } else {
+            ++it;
+        }
+    }
+    return framesAvailable;
+}
+
+void PubSubTcpBridge::publishReceivedMessages() {
+    this->_publishing = true;
+    for (Connection &connection : this->_connections) {
+        char *frame;
+        size_t length;
+        while (connection.rxBuffer.nextFrame(frame, length)) {
+            int result = extMessageHandler::handleExtMessage(frame,
+                    [this](PubSubMsg &msg) {
+                        this->publishMessage(msg);
+                    });
+            if (result == 0) {
+                this->_numReceived++;
+            } else {
+                this->_numInvalid++;
+                EV_WARN << "Ignoring invalid message from external controller"
+                               << omnetpp::endl;
+            }
+        }
+    }
+    this->_publishing = false;
+}
+
+void PubSubTcpBridge::receivedPubSubMessage(PubSubMsg *pubSubMsg) {
+    if (this->_publishing || this->_connections.empty()) {
+        return;
+    }
+    std::string message;
+    extMessageHandler::buildExtMessage(*pubSubMsg, message);
+    if (message.length() > FrameReceiveBuffer::MAX_FRAME_LENGTH) {
+        throw omnetpp::cRuntimeError("message longer than 16-bit size");
+    }
+    char lengthBytes[2];
+    lengthBytes[0] = (message.length() >> 8) & 0xFF;
+    lengthBytes[1] = (message.length() >> 0) & 0xFF;
+    for (auto it = this->_connections.begin(); it != this->_connections.end();) {
+        Connection &connection = *it;
+        if (connection.txBuffer.length() + 2 + message.length()
+                > this->_maxSendBufferSize) {
+            // the controller stopped reading, drop it instead of buffering
+            // without bound
+            EV_WARN << "Disconnecting external controller, "
+                           << connection.txBuffer.length()
+                           << " bytes are waiting to be sent" << omnetpp::endl;
+            this->_numOverflows++;
+            close_socket(connection.sockfd);
+            it = this->_connections.erase(it);
+            continue;
+        }
+        connection.txBuffer.append(lengthBytes, 2);
+        connection.txBuffer.append(message);
+        this->flush(connection);
+        ++it;
+    }
+    this->_numSent++;
+}
+
+bool PubSubTcpBridge::flush(Connection &connection) {
+    while (!connection.txBuffer.empty()) {
+        ssize_t sent = ::send(connection.sockfd, connection.txBuffer.data(),
+                connection.txBuffer.length(), SOCKET_SEND_FLAGS);
+        if (sent < 0) {
+            // remaining bytes are sent when the scheduler checks the sockets next time
+            return socket_would_block();
+        }
+        connection.txBuffer.erase(0, sent);
+    }
+    return true;
+}
+
+void PubSubTcpBridge::closeSockets() {
+    for (Connection &connection : this->_connections) {
+        close_socket(connection.sockfd);
+    }
+    this->_connections.clear();
+    close_socket(this->_listenSockfd);
+    this->_listenSockfd = -1;
+}
+
+}  // namespace estnet
@@ -0,0 +1,110 @@
+//
+// Copyright (C) 2020 Computer Science VII: Robotics and Telematics - 
+// Julius-Maximilians-Universitaet Wuerzburg
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see http://www.gnu.org/licenses/.
+//
+
+
+#ifndef __ESTNET_PUBSUBTCPBRIDGE_H_
+#define __ESTNET_PUBSUBTCPBRIDGE_H_
+
+#include <list>
+#include <string>
+#include <vector>
+
+#include "estnet/common/FrameReceiveBuffer.h"
+#include "estnet/siminterface/pubsub/SimplePublisher.h"
+#include "estnet/siminterface/pubsub/Subscriber.h"
+
+namespace estnet {
+
+/**
+ * Bridges the PubSub system to external processes over TCP.
+ * External controllers connect to the listening port and exchange
+ * messages framed by a 16-bit big endian length, containing JSON as
+ * described in ~extMessageHandler. Incoming messages are published
+ * on their topic, messages published on the forwarded topics are sent
+ * to all connected controllers.
+ * Sockets are never read during event handling: with ~PubSubTcpScheduler
+ * the scheduler checks them between events and schedules a notification,
+ * otherwise the bridge polls them every pollInterval of simulation time.
+ * A controller that does not read its messages is disconnected once more
+ * than maxSendBufferSize bytes are waiting to be sent to it.
+ */
+class ESTNET_API PubSubTcpBridge: public SimplePublisher, public Subscriber {
+public:
+    PubSubTcpBridge();
+    virtual ~PubSubTcpBridge();
+
+    /** @brief returns the listening socket and all connected sockets */
+    void getSockets(std::vector<int> &sockets) const;
+    /**
+     * Accepts new connections and reads all available bytes without
+     * blocking. Does not use the simulation, so it can be called by the
+     * scheduler outside of event handling.
+     * @return true if complete messages are waiting to be published
+     */
+    bool receiveAvailableData();
+    /** @brief returns the TCP port the bridge is listening on */
+    int getPort() const {
+        return this->_port;
+    }
+    /** @brief returns the message to schedule if data arrived */
+    omnetpp::cMessage* getDataArrivedMessage() const {
+        return this->_dataArrived;
+    }
+
+protected:
+    /** @brief opens the listening socket and registers at the scheduler */
+    virtual void initialize() override;
+    /** @brief publishes the received messages */
+    virtual void handleMessage(omnetpp::cMessage *msg) override;
+    /** @brief closes all sockets */
+    virtual void finish() override;
+    /** @brief forwards the message to all connected controllers */
+    virtual void receivedPubSubMessage(PubSubMsg *pubSubMsg) override;
+
+private:
+    /** state of one connected controller */
+    struct Connection {
+        int sockfd;
+        FrameReceiveBuffer rxBuffer;
+        std::string txBuffer;
+    };
+
+    /** @brief publishes all completely received messages */
+    void publishReceivedMessages();
+    /** @brief sends as much of the pending bytes as possible without blocking */
+    bool flush(Connection &connection);
+    /** @brief closes all sockets */
+    void closeSockets();
+
+    int _listenSockfd = -1;
+    int _port = -1;
+    size_t _maxSendBufferSize;
+    std::list<Connection> _connections;
+    omnetpp::cMessage *_dataArrived = nullptr;
+    omnetpp::cMessage *_pollTimer = nullptr;
+    omnetpp::simtime_t _pollInterval;
+    bool _publishing = false;   // suppresses forwarding messages received from outside
+    long _numReceived = 0;
+    long _numSent = 0;
+    long _numInvalid = 0;
+    long _numOverflows = 0;     // controllers disconnected because they did not read
+};
+
+}  // namespace estnet
+
+#endif
@@ -0,0 +1,153 @@
+//
+// Copyright (C) 2020 Computer Science VII: Robotics and Telematics - 
+// Julius-Maximilians-Universitaet Wuerzburg
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see http://www.gnu.org/licenses/.
+//
+
+
+#include "PubSubTcpScheduler.h"
+
+#include <algorithm>
+
+#include "estnet/protocol/common/SocketUtils.h"
+#include "estnet/siminterface/tcpinterface/PubSubTcpBridge.h"
+
+namespace estnet {
+
+Register_Class(PubSubTcpScheduler);
+
+Register_GlobalConfigOption(CFGID_PUBSUBTCP_REALTIME_SCALING,
+        "pubsubtcp-realtime-scaling", CFG_DOUBLE, "0",
+        "PubSubTcpScheduler: simulated seconds per wall clock second, 0 runs as fast as possible");
+Register_GlobalConfigOption(CFGID_PUBSUBTCP_POLL_INTERVAL,
+        "pubsubtcp-poll-interval", CFG_DOUBLE, "0.01",
+        "PubSubTcpScheduler: wall clock seconds between socket checks when not running in real time");
+
+// maximum time to wait for sockets, keeps the user interface responsive
+static const double MAX_WAIT = 0.1;
+
+std::string PubSubTcpScheduler::str() const {
+    return "PubSubTcpScheduler";
+}
+
+void PubSubTcpScheduler::startRun() {
+    this->_scaling = omnetpp::getEnvir()->getConfig()->getAsDouble(
+            CFGID_PUBSUBTCP_REALTIME_SCALING);
+    this->_pollInterval = omnetpp::getEnvir()->getConfig()->getAsDouble(
+            CFGID_PUBSUBTCP_POLL_INTERVAL);
+    if (this->_scaling < 0) {
+        throw omnetpp::cRuntimeError(
+                "PubSubTcpScheduler: pubsubtcp-realtime-scaling must not be negative");
+    }
+    this->_lastPoll = clock::now();
+    this->_baseTime = clock::now();
+    this->_baseSimTime = this->sim->getSimTime();
+}
+
+void PubSubTcpScheduler::executionResumed() {
+    this->_baseTime = clock::now();
+    this->_baseSimTime = this->sim->getSimTime();
+}
+
+omnetpp::cEvent* PubSubTcpScheduler::takeNextEvent() {
+    if (this->_scaling > 0) {
+        // wait for the next event to be due, handling socket data meanwhile
+        while (true) {
+            omnetpp::cEvent *event = this->sim->getFES()->peekFirst();
+            if (event == nullptr && this->_bridges.empty()) {
+                break;
+            }
+            double waitTime = MAX_WAIT;
+            if (event != nullptr) {
+                waitTime = (event->getArrivalTime() - this->getRealTimeSimTime()).dbl()
+                        / this->_scaling;
+                if (waitTime <= 0) {
+                    break;
+                }
+            }
+            if (omnetpp::getEnvir()->idle()) {
+                // the user interrupted the simulation
+                return nullptr;
+            }
+            this->checkSockets(std::min(waitTime, MAX_WAIT));
+        }
+    } else if (!this->_bridges.empty()) {
+        clock::time_point now = clock::now();
+        if (std::chrono::duration<double>(now - this->_lastPoll).count()
+                >= this->_pollInterval) {
+            this->_lastPoll = now;
+            this->checkSockets(0);
+        }
+    }
+    return omnetpp::cSequentialScheduler::takeNextEvent();
+}
+
+void PubSubTcpScheduler::addBridge(PubSubTcpBridge *bridge) {
+    this->_bridges.push_back(bridge);
+}
+
+void PubSubTcpScheduler::removeBridge(PubSubTcpBridge *bridge) {
+    this->_bridges.erase(
+            std::remove(this->_bridges.begin(), this->_bridges.end(), bridge),
+            this->_bridges.end());
+}
+
+bool PubSubTcpScheduler::checkSockets(double timeout) {
+    std::vector<int> sockets;
+    for (PubSubTcpBridge *bridge : this->_bridges) {
+        bridge->getSockets(sockets);
+    }
+    fd_set sockset;
+    FD_ZERO(&sockset);
+    int maxSockfd = -1;
+    for (int sockfd : sockets) {
+        FD_SET(sockfd, &sockset);
+        maxSockfd = std::max(maxSockfd, sockfd);
+    }
+    struct timeval tv;
+    tv.tv_sec = (long) timeout;
+    tv.tv_usec = (long) ((timeout - tv.tv_sec) * 1e6);
+    int result = select(maxSockfd + 1, &sockset, nullptr, nullptr, &tv);
+    if (result <= 0) {
+        return false;
+    }
+
+    bool inserted = false;
+    for (PubSubTcpBridge *bridge : this->_bridges) {
+        omnetpp::cMessage *dataArrived = bridge->getDataArrivedMessage();
+        if (bridge->receiveAvailableData() && !dataArrived->isScheduled()) {
+            omnetpp::simtime_t arrivalTime = this->sim->getSimTime();
+            if (this->_scaling > 0) {
+                arrivalTime = std::max(arrivalTime, this->getRealTimeSimTime());
+                omnetpp::cEvent *next = this->sim->getFES()->peekFirst();
+                if (next != nullptr) {
+                    arrivalTime = std::min(arrivalTime, next->getArrivalTime());
+                }
+            }
+            dataArrived->setArrival(bridge->getId(), -1, arrivalTime);
+            this->sim->getFES()->insert(dataArrived);
+            inserted = true;
+        }
+    }
+    return inserted;
+}
+
+omnetpp::simtime_t PubSubTcpScheduler::getRealTimeSimTime() const {
+    double elapsed =
+            std::chrono::duration<double>(clock::now() - this->_baseTime).count();
+    return this->_baseSimTime + elapsed * this->_scaling;
+}
+
+}  // namespace estnet
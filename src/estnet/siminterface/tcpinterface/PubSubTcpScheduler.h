@@ -0,0 +1,82 @@
+//
+// Copyright (C) 2020 Computer Science VII: Robotics and Telematics - 
+// Julius-Maximilians-Universitaet Wuerzburg
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see http://www.gnu.org/licenses/.
+//
+
+
+#ifndef __ESTNET_PUBSUBTCPSCHEDULER_H_
+#define __ESTNET_PUBSUBTCPSCHEDULER_H_
+
+#include <chrono>
+#include <vector>
+
+#include "estnet/common/ESTNETDefs.h"
+
+namespace estnet {
+
+class PubSubTcpBridge;
+
+/**
+ * Scheduler checking the sockets of all ~PubSubTcpBridge modules between
+ * events, so the bridges neither poll on every event nor need timers.
+ * Select with scheduler-class = "estnet::PubSubTcpScheduler".
+ *
+ * By default the simulation runs as fast as possible and the sockets are
+ * checked without waiting at most every pubsubtcp-poll-interval seconds of
+ * wall clock time. With pubsubtcp-realtime-scaling greater than zero the
+ * simulation is synchronized to the wall clock (simulated seconds per
+ * wall clock second) and the scheduler waits for socket data until the
+ * next event is due, so external messages are delivered without delay.
+ */
+class ESTNET_API PubSubTcpScheduler: public omnetpp::cSequentialScheduler {
+public:
+    /** @brief returns a description for the user interface */
+    virtual std::string str() const override;
+    /** @brief reads the configuration */
+    virtual void startRun() override;
+    /** @brief resynchronizes to the wall clock after the simulation was paused */
+    virtual void executionResumed() override;
+    /** @brief checks the sockets before returning the next event */
+    virtual omnetpp::cEvent* takeNextEvent() override;
+
+    /** @brief checks the sockets of the given bridge from now on */
+    void addBridge(PubSubTcpBridge *bridge);
+    /** @brief stops checking the sockets of the given bridge */
+    void removeBridge(PubSubTcpBridge *bridge);
+
+private:
+    typedef std::chrono::steady_clock clock;
+
+    /**
+     * Waits up to timeout seconds for data on the sockets and lets the
+     * bridges receive it.
+     * @return true if a notification event was inserted
+     */
+    bool checkSockets(double timeout);
+    /** @brief returns the simulation time corresponding to now in real time mode */
+    omnetpp::simtime_t getRealTimeSimTime() const;
+
+    std::vector<PubSubTcpBridge*> _bridges;
+    double _scaling = 0;
+    double _pollInterval = 0;
+    clock::time_point _lastPoll;
+    clock::time_point _baseTime;
+    omnetpp::simtime_t _baseSimTime;
+};
+
+}  // namespace estnet
+
+#endif
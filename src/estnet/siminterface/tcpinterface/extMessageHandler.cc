@@ -18,53 +18,115 @@
 
 #include "extMessageHandler.h"
 
-#include "estnet/common/rapidjson/document.h" // rapidjson's DOM-style API
-#include "estnet/common/rapidjson/writer.h"
-#include "estnet/common/rapidjson/stringbuffer.h"
-#include "estnet/common/rapidjson/filereadstream.h"
-#include "estnet/common/rapidjson/error/en.h"
+#include <vector>
 
-using namespace rapidjson;
+#include <rapidjson/document.h> // rapidjson's DOM-style API
+#include <rapidjson/writer.h>
+#include <rapidjson/stringbuffer.h>
+#include <cppcodec/base64_default_rfc4648.hpp>
 
 namespace estnet {
 
-int extMessageHandler::handleExtMessage(std::string const &message) {
-
-    Document document;
+int extMessageHandler::handleExtMessage(char *message,
+        const tPublishCallback &publish) {
+    rapidjson::Document document;
+    if (document.ParseInsitu<rapidjson::kParseFullPrecisionFlag>(
+            message).HasParseError()
+            || !document.IsObject()) {
+        return -1;
+    }
+    auto topicIt = document.FindMember("topic");
+    if (topicIt == document.MemberEnd() || !topicIt->value.IsString()) {
+        return -1;
+    }
+    tPubSubKey topic(topicIt->value.GetString(),
+            topicIt->value.GetStringLength());
 
-    // Read json from file
-    FILE *fp;
-    // example_JSON_oneConnection
-    if ((fp =
-            fopen(
-                    (std::string(getenv("HOME"))
-                            + std::string(
-                                    "/Downloads/example_JSON_oneConnection.json")).c_str(),
-                    "r")) == NULL) // non-Windows use "r"
-    {
-        std::cout << "Error: " << strerror(errno) << endl;
+    auto blobIt = document.FindMember("blob");
+    if (blobIt != document.MemberEnd() && blobIt->value.IsString()) {
+        tPubSubBlob blob;
+        try {
+            blob = base64::decode(blobIt->value.GetString(),
+                    blobIt->value.GetStringLength());
+        } catch (cppcodec::parse_error &e) {
+            return -1;
+        }
+        PubSubMsg msg(topic, blob);
+        publish(msg);
+        return 0;
     }
 
-    char readBuffer[65536];
-    FileReadStream is(fp, readBuffer, sizeof(readBuffer));
-    if (document.ParseStream(is).HasParseError()) {
-        fprintf(stderr, "\nError(offset %u): %s\n",
-                (unsigned) document.GetErrorOffset(),
-                GetParseError_En(document.GetParseError()));
+    auto valueIt = document.FindMember("value");
+    if (valueIt == document.MemberEnd()) {
+        return -1;
     }
-    fclose(fp);
+    const rapidjson::Value &value = valueIt->value;
+    if (value.IsNumber()) {
+        PubSubMsg msg(topic, value.GetDouble());
+        publish(msg);
+    } else if (value.IsString()) {
+        tPubSubValue stringValue(value.GetString(), value.GetStringLength());
+        PubSubMsg msg(topic, stringValue);
+        publish(msg);
+    } else if (value.IsArray()) {
+        tPubSubVector vector;
+        vector.reserve(value.Size());
+        for (const rapidjson::Value &element : value.GetArray()) {
+            if (!element.IsNumber()) {
+                return -1;
+            }
+            vector.push_back(element.GetDouble());
+        }
+        PubSubMsg msg(topic, vector);
+        publish(msg);
+    } else {
+        return -1;
+    }
+    return 0;
+}
 
-    // Convert JSON document to string
-    StringBuffer strbuf;
-    Writer<StringBuffer> writer(strbuf);
-    document.Accept(writer);
+int extMessageHandler::handleExtMessage(std::string const &message,
+        const tPublishCallback &publish) {
+    std::vector<char> buffer(message.begin(), message.end());
+    buffer.push_back('\0');
+    return handleExtMessage(&buffer[0], publish);
+}
 
-    for (auto &m : document.GetObject()) {
-        // Using a reference for consecutive access is handy and faster.
-        const Value &a = document[m.name.GetString()];
+void extMessageHandler::buildExtMessage(const PubSubMsg &pubSubMsg,
+        std::string &message) {
+    rapidjson::StringBuffer s;
+    rapidjson::Writer<rapidjson::StringBuffer> jsonWriter(s);
+    jsonWriter.StartObject();
+    jsonWriter.Key("topic");
+    jsonWriter.String(pubSubMsg.getKey().c_str(),
+            pubSubMsg.getKey().length());
+    switch (pubSubMsg.getType()) {
+    case PubSubPayloadType::STRING:
+        jsonWriter.Key("value");
+        jsonWriter.String(pubSubMsg.getValue().c_str(),
+                pubSubMsg.getValue().length());
+        break;
+    case PubSubPayloadType::NUMBER:
+        jsonWriter.Key("value");
+        jsonWriter.Double(pubSubMsg.getNumber());
+        break;
+    case PubSubPayloadType::VECTOR:
+        jsonWriter.Key("value");
+        jsonWriter.StartArray();
+        for (double element : pubSubMsg.getVector()) {
+            jsonWriter.Double(element);
+        }
+        jsonWriter.EndArray();
+        break;
+    case PubSubPayloadType::BLOB: {
+        std::string encodedBlob = base64::encode(pubSubMsg.getBlob());
+        jsonWriter.Key("blob");
+        jsonWriter.String(encodedBlob.c_str(), encodedBlob.length());
+        break;
     }
-
-    return 0;
+    }
+    jsonWriter.EndObject();
+    message = s.GetString();
 }
 
 }  // namespace estnet
@@ -19,24 +19,43 @@
 #ifndef __SATKOMMMA_EXMESSAGEHANDLER_H_
 #define __SATKOMMMA_EXMESSAGEHANDLER_H_
 
-#include "estnet/siminterface/pubsub/Publisher.h"
+#include <functional>
+#include <string>
 
-using namespace omnetpp;
+#include "estnet/siminterface/pubsub/PubSubMessage.h"
 
 namespace estnet {
 
 /**
- * handles external messages that arrieved on the tcp interface
+ * handles external messages that arrived on the tcp interface.
+ * Messages are JSON objects with the topic and either a value, which is
+ * a string, a number or an array of numbers, or a base64 encoded blob:
+ * {"topic": "/omnet/sat/1/nodefailure", "value": 1}
  */
-class ESTNET_API extMessageHandler: public Publisher {
+class ESTNET_API extMessageHandler {
 public:
+    /** callback receiving the decoded message, which is only valid during the call */
+    typedef std::function<void(PubSubMsg&)> tPublishCallback;
+
     /**
      * Handler for message
-     * @param message: string message in JSON format that has to be handled
+     * @param message: null terminated message in JSON format that has to be handled,
+     *                 it is parsed in situ and therefore modified
+     * @param publish: called with the decoded message
      * @return int: success indicator, returns 0 if message was
      *              handled successfully
      */
-    static int handleExtMessage(std::string const &message);
+    static int handleExtMessage(char *message, const tPublishCallback &publish);
+    /** @brief same as above, but copies the message before parsing */
+    static int handleExtMessage(std::string const &message,
+            const tPublishCallback &publish);
+    /**
+     * Encodes the given message in JSON format
+     * @param pubSubMsg: message to encode
+     * @param message: set to the JSON string
+     */
+    static void buildExtMessage(const PubSubMsg &pubSubMsg,
+            std::string &message);
 };
 
 }  // namespace estnet